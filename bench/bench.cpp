@@ -0,0 +1,501 @@
+#include "solver.h"
+#include "generators.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// the benchmark harness: it repeatedly solves the problems of the 'examples' folder and writes a JSON report with the statistical summaries of the wall time, of the phase times and of the solver's counters..
+//
+//     lucy_bench [--runs n] [--warmup n] [--timeout seconds] [--filter substring] <examples folder> <report.json>
+//     lucy_bench --compare [--threshold fraction] <base report.json> <new report.json>
+//     lucy_bench --scale <generator>[:<parameter>] --sizes <size>,<size>,.. [--runs n] [--timeout seconds] <examples folder> <report.csv>
+//
+// the comparison mode compares two reports (e.g., produced by two different builds) and exits with a non-zero status if the new one has some performance regression..
+// the scaling mode solves problems of increasing size built by one of the generators of 'generators.h' (i.e., 'blocks', 'logistics:<trucks>', 'sv' or 'rr:<capacity>'), writing the median times and memory for each size into a CSV file, along with a gnuplot script which plots them..
+
+struct benchmark
+{
+    std::string name;
+    std::vector<std::string> files;
+    std::string script = ""; // a (generated) problem, read after the files (if any)..
+};
+
+// the benchmarks, relative to the 'examples' folder..
+std::vector<benchmark> get_benchmarks(const std::string &dir)
+{
+    std::vector<benchmark> bs;
+    for (int i = 2; i <= 10; ++i)
+    {
+        const std::string n = (i < 10 ? "0" : "") + std::to_string(i);
+        bs.push_back({"blocks_" + n, {dir + "/blocks/blocks_domain.rddl", dir + "/blocks/blocks_problem_" + n + ".rddl"}});
+    }
+    for (int i = 0; i <= 2; ++i)
+        bs.push_back({"logistics_" + std::to_string(i), {dir + "/logistics/logistics_domain.rddl", dir + "/logistics/logistics_problem_" + std::to_string(i) + ".rddl"}});
+    for (int i = 0; i <= 2; ++i)
+        bs.push_back({"logistics_sv_" + std::to_string(i), {dir + "/logistics_state_variables/logistics_domain.rddl", dir + "/logistics_state_variables/logistics_problem_" + std::to_string(i) + ".rddl"}});
+    bs.push_back({"tms_1_001", {dir + "/tms/tms_domain.rddl", dir + "/tms/tms_problem_1_001.rddl"}});
+    bs.push_back({"cc_1_001", {dir + "/cc/cc_domain.rddl", dir + "/cc/cc_problem_1_001.rddl"}});
+    return bs;
+}
+
+// flattens the numbers and the strings of the given JSON document into maps whose keys are the paths of the members (e.g., 'time.parse'), array elements are keyed by their index..
+class json_flattener
+{
+public:
+    json_flattener(const std::string &json, std::map<std::string, double> &nums, std::map<std::string, std::string> &strs) : json(json), nums(nums), strs(strs)
+    {
+        value("");
+        skip();
+        if (pos != json.size())
+            error();
+    }
+
+private:
+    void value(const std::string &path)
+    {
+        skip();
+        switch (peek())
+        {
+        case '{':
+            pos++;
+            skip();
+            if (peek() == '}')
+            {
+                pos++;
+                return;
+            }
+            while (true)
+            {
+                skip();
+                const std::string key = string();
+                skip();
+                if (next() != ':')
+                    error();
+                value(path.empty() ? key : path + "." + key);
+                skip();
+                const char c = next();
+                if (c == '}')
+                    return;
+                else if (c != ',')
+                    error();
+            }
+        case '[':
+        {
+            pos++;
+            skip();
+            if (peek() == ']')
+            {
+                pos++;
+                return;
+            }
+            size_t i = 0;
+            while (true)
+            {
+                value(path.empty() ? std::to_string(i) : path + "." + std::to_string(i));
+                i++;
+                skip();
+                const char c = next();
+                if (c == ']')
+                    return;
+                else if (c != ',')
+                    error();
+            }
+        }
+        case '"':
+            strs[path] = string();
+            return;
+        default:
+        {
+            size_t end = 0;
+            try
+            {
+                nums[path] = std::stod(json.substr(pos, 32), &end);
+            }
+            catch (const std::logic_error &)
+            {
+                error();
+            }
+            pos += end;
+        }
+        }
+    }
+
+    std::string string()
+    {
+        if (next() != '"')
+            error();
+        const size_t end = json.find('"', pos);
+        if (end == std::string::npos)
+            error();
+        std::string str = json.substr(pos, end - pos);
+        pos = end + 1;
+        return str;
+    }
+
+    // the current character, a truncated report raises an error..
+    char peek()
+    {
+        if (pos >= json.size())
+            error();
+        return json[pos];
+    }
+    char next()
+    {
+        const char c = peek();
+        pos++;
+        return c;
+    }
+
+    void skip()
+    {
+        while (pos < json.size() && isspace(static_cast<unsigned char>(json[pos])))
+            pos++;
+    }
+
+    [[noreturn]] void error() { throw std::invalid_argument("invalid JSON at position " + std::to_string(pos)); }
+
+private:
+    const std::string &json;
+    std::map<std::string, double> &nums;
+    std::map<std::string, std::string> &strs;
+    size_t pos = 0;
+};
+
+// the memory currently allocated by the process, in KB (where available)..
+double allocated_memory()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    const struct mallinfo2 mi = mallinfo2();
+    return (mi.uordblks + mi.hblkhd) / 1024.0;
+#elif defined(__linux__)
+    std::ifstream ifs("/proc/self/statm"); // the resident memory, which does not account for the memory reused by the allocator..
+    size_t size = 0, resident = 0;
+    ifs >> size >> resident;
+    return resident * 4.0;
+#else
+    return 0;
+#endif
+}
+
+std::string read_file(const std::string &file)
+{
+    std::ifstream ifs(file);
+    if (!ifs)
+        throw std::invalid_argument("file not found: " + file);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+// solves the given benchmark once, returning its outcome and filling the given metrics..
+std::string run(const benchmark &b, const double &timeout, std::map<std::string, double> &metrics)
+{
+    std::string status = "solved";
+    std::streambuf *out = std::cout.rdbuf(nullptr); // the solver's (debug) output is discarded..
+    const double mem = allocated_memory();
+    const auto start = std::chrono::steady_clock::now();
+    cg::solver s;
+    try
+    {
+        s.init();
+        s.set_deadline(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout)));
+        if (!b.files.empty())
+            s.read(b.files);
+        if (!b.script.empty())
+            s.read(b.script);
+        s.solve();
+    }
+    catch (const interrupted_exception &)
+    {
+        status = "timeout";
+    }
+    catch (const unsolvable_exception &)
+    {
+        status = "unsolvable";
+    }
+    catch (const std::exception &)
+    {
+        status = "error";
+    }
+    metrics["wall"] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    metrics["memory"] = std::max(allocated_memory() - mem, 0.0); // the memory retained by the solver (a lower bound of its peak)..
+
+    std::map<std::string, std::string> strs;
+    json_flattener(s.get_statistics(), metrics, strs);
+    std::cout.rdbuf(out);
+    return status;
+}
+
+struct summary
+{
+    double mean, stddev, median, min, max;
+};
+
+summary summarize(std::vector<double> vals)
+{
+    std::sort(vals.begin(), vals.end());
+    summary s;
+    s.min = vals.front();
+    s.max = vals.back();
+    s.median = vals.size() % 2 ? vals[vals.size() / 2] : (vals[vals.size() / 2 - 1] + vals[vals.size() / 2]) / 2;
+    double sum = 0;
+    for (const auto &v : vals)
+        sum += v;
+    s.mean = sum / vals.size();
+    double sq = 0;
+    for (const auto &v : vals)
+        sq += (v - s.mean) * (v - s.mean);
+    s.stddev = vals.size() > 1 ? std::sqrt(sq / (vals.size() - 1)) : 0;
+    return s;
+}
+
+// writes the given (flattened) metrics, nesting them back according to their paths..
+void write_metrics(std::ostream &os, const std::map<std::string, summary> &sums)
+{
+    std::string c_group;
+    os << "\"metrics\" : { ";
+    for (std::map<std::string, summary>::const_iterator s_it = sums.begin(); s_it != sums.end(); ++s_it)
+    {
+        const size_t dot = s_it->first.find('.');
+        const std::string group = dot == std::string::npos ? "" : s_it->first.substr(0, dot);
+        const std::string name = dot == std::string::npos ? s_it->first : s_it->first.substr(dot + 1);
+        if (group != c_group && !c_group.empty())
+            os << " }";
+        if (s_it != sums.begin())
+            os << ", ";
+        if (group != c_group && !group.empty())
+            os << "\"" << group << "\" : { ";
+        c_group = group;
+        os << "\"" << name << "\" : { \"mean\" : " << s_it->second.mean << ", \"stddev\" : " << s_it->second.stddev << ", \"median\" : " << s_it->second.median << ", \"min\" : " << s_it->second.min << ", \"max\" : " << s_it->second.max << " }";
+    }
+    if (!c_group.empty())
+        os << " }";
+    os << " }";
+}
+
+int bench(const std::string &dir, const std::string &report, const size_t &runs, const size_t &warmup, const double &timeout, const std::string &filter)
+{
+    std::ofstream os(report);
+    os.precision(6);
+    os << std::fixed;
+    os << "{ \"runs\" : " << runs << ", \"warmup\" : " << warmup << ", \"timeout\" : " << timeout << ", \"benchmarks\" : { ";
+    bool first = true;
+    for (const auto &b : get_benchmarks(dir))
+    {
+        if (b.name.find(filter) == std::string::npos)
+            continue;
+        std::cout << b.name << ".." << std::flush;
+
+        std::string status;
+        std::map<std::string, std::vector<double>> samples;
+        for (size_t i = 0; i < warmup + runs; ++i)
+        {
+            std::map<std::string, double> metrics;
+            status = run(b, timeout, metrics);
+            if (i >= warmup || status != "solved")
+                for (const auto &m : metrics)
+                    samples[m.first].push_back(m.second);
+            if (status != "solved") // there is no point in repeating failing runs..
+                break;
+        }
+
+        std::map<std::string, summary> sums;
+        for (const auto &s : samples)
+            sums[s.first] = summarize(s.second);
+
+        if (!first)
+            os << ", ";
+        first = false;
+        os << "\"" << b.name << "\" : { \"status\" : \"" << status << "\", ";
+        write_metrics(os, sums);
+        os << " }";
+        std::cout << " " << status;
+        if (sums.count("wall"))
+            std::cout << " (median " << sums.at("wall").median << " ms)";
+        std::cout << std::endl;
+    }
+    os << " } }" << std::endl;
+    return 0;
+}
+
+int scale(const std::string &dir, const std::string &report, const std::string &gen, const std::vector<size_t> &sizes, const size_t &runs, const double &timeout)
+{
+    const size_t colon = gen.find(':');
+    const std::string kind = gen.substr(0, colon);
+    const size_t par = colon == std::string::npos ? 0 : std::stoul(gen.substr(colon + 1));
+
+    std::ofstream os(report);
+    os.precision(3);
+    os << std::fixed;
+    os << "size,status,wall,parse,build,search,memory" << std::endl;
+    for (const auto &n : sizes)
+    {
+        benchmark b;
+        b.name = kind + "_" + std::to_string(n);
+        if (kind == "blocks")
+        {
+            b.files.push_back(dir + "/blocks/blocks_domain.rddl");
+            b.script = blocks_problem(n);
+        }
+        else if (kind == "logistics")
+        {
+            b.files.push_back(dir + "/logistics/logistics_domain.rddl");
+            b.script = logistics_problem(par ? par : 2, n);
+        }
+        else if (kind == "sv")
+            b.script = state_variable_problem(n);
+        else if (kind == "rr")
+            b.script = reusable_resource_problem(n, par ? par : 2);
+        else
+            throw std::invalid_argument("unknown generator: " + kind);
+        std::cout << b.name << ".." << std::flush;
+
+        std::string status;
+        std::map<std::string, std::vector<double>> samples;
+        for (size_t i = 0; i < runs; ++i)
+        {
+            std::map<std::string, double> metrics;
+            status = run(b, timeout, metrics);
+            for (const auto &m : metrics)
+                samples[m.first].push_back(m.second);
+            if (status != "solved")
+                break;
+        }
+
+        os << n << "," << status;
+        for (const auto &m : {"wall", "time.parse", "time.build", "time.search", "memory"})
+            os << "," << summarize(samples.at(m)).median;
+        os << std::endl;
+        std::cout << " " << status << " (median " << summarize(samples.at("wall")).median << " ms, " << summarize(samples.at("memory")).median << " KB)" << std::endl;
+        if (status != "solved") // larger problems would fail as well..
+            break;
+    }
+
+    std::ofstream gp(report + ".gp");
+    gp << "set datafile separator ','\n";
+    gp << "set terminal png size 1200,500\n";
+    gp << "set output '" << report << ".png'\n";
+    gp << "set multiplot layout 1,2 title '" << gen << "'\n";
+    gp << "set xlabel 'size'\nset ylabel 'time (ms)'\nset key top left\n";
+    gp << "plot '" << report << "' using 1:3 every ::1 with linespoints title 'wall', '' using 1:5 every ::1 with linespoints title 'build', '' using 1:6 every ::1 with linespoints title 'search'\n";
+    gp << "set ylabel 'memory (KB)'\n";
+    gp << "plot '" << report << "' using 1:7 every ::1 with linespoints title 'memory'\n";
+    gp << "unset multiplot\n";
+    return 0;
+}
+
+int compare(const std::string &base_report, const std::string &new_report, const double &threshold)
+{
+    std::map<std::string, double> b_nums, n_nums;
+    std::map<std::string, std::string> b_strs, n_strs;
+    json_flattener(read_file(base_report), b_nums, b_strs);
+    json_flattener(read_file(new_report), n_nums, n_strs);
+
+    const std::vector<std::string> times = {"wall", "time.parse", "time.build", "time.search"};
+    size_t n_regressions = 0;
+    std::cout.precision(3);
+    std::cout << std::fixed;
+    for (const auto &s : b_strs)
+    {
+        const std::string prefix = "benchmarks.";
+        if (s.first.compare(0, prefix.size(), prefix) != 0 || s.first.size() < 7 || s.first.compare(s.first.size() - 7, 7, ".status") != 0)
+            continue;
+        const std::string b_name = s.first.substr(prefix.size(), s.first.size() - prefix.size() - 7);
+        const auto at_new = n_strs.find(s.first);
+        if (at_new == n_strs.end())
+            continue;
+        if (s.second != at_new->second)
+        {
+            std::cout << b_name << ": " << s.second << " -> " << at_new->second << std::endl;
+            if (s.second == "solved")
+                n_regressions++;
+            continue;
+        }
+
+        for (const auto &t : times)
+        {
+            const std::string key = prefix + b_name + ".metrics." + t + ".";
+            if (!b_nums.count(key + "median") || !n_nums.count(key + "median"))
+                continue;
+            const double b_med = b_nums.at(key + "median"), n_med = n_nums.at(key + "median");
+            const double noise = 2 * std::max(b_nums.at(key + "stddev"), n_nums.at(key + "stddev"));
+            const double delta = b_med > 0 ? (n_med - b_med) / b_med : 0;
+            // a slowdown is a regression only if it exceeds both the threshold and the noise of the measurements (and it is not negligible)..
+            const bool regression = delta > threshold && n_med - b_med > noise && n_med - b_med > 1;
+            if (regression)
+                n_regressions++;
+            std::cout << b_name << " " << t << ": " << b_med << " ms -> " << n_med << " ms (" << (delta >= 0 ? "+" : "") << delta * 100 << "%)" << (regression ? " REGRESSION" : "") << std::endl;
+        }
+    }
+    std::cout << n_regressions << " regressions found.." << std::endl;
+    return n_regressions ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t runs = 5;
+    size_t warmup = 1;
+    double timeout = 60;
+    double threshold = 0.1;
+    std::string filter;
+    bool cmp = false;
+    std::string gen;
+    std::vector<size_t> sizes;
+    std::vector<std::string> args;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--compare")
+                cmp = true;
+            else if (i + 1 < argc && arg == "--runs")
+                runs = std::stoul(argv[++i]);
+            else if (i + 1 < argc && arg == "--warmup")
+                warmup = std::stoul(argv[++i]);
+            else if (i + 1 < argc && arg == "--timeout")
+                timeout = std::stod(argv[++i]);
+            else if (i + 1 < argc && arg == "--threshold")
+                threshold = std::stod(argv[++i]);
+            else if (i + 1 < argc && arg == "--filter")
+                filter = argv[++i];
+            else if (i + 1 < argc && arg == "--scale")
+                gen = argv[++i];
+            else if (i + 1 < argc && arg == "--sizes")
+            {
+                std::stringstream ss(argv[++i]);
+                std::string size;
+                while (std::getline(ss, size, ','))
+                    sizes.push_back(std::stoul(size));
+            }
+            else
+                args.push_back(arg);
+        }
+        if (args.size() != 2 || runs == 0 || gen.empty() != sizes.empty())
+        {
+            std::cerr << "usage: lucy_bench [--runs n] [--warmup n] [--timeout seconds] [--filter substring] <examples folder> <report.json>" << std::endl;
+            std::cerr << "       lucy_bench --compare [--threshold fraction] <base report.json> <new report.json>" << std::endl;
+            std::cerr << "       lucy_bench --scale <generator>[:<parameter>] --sizes <size>,<size>,.. [--runs n] [--timeout seconds] <examples folder> <report.csv>" << std::endl;
+            return 2;
+        }
+
+        if (cmp)
+            return compare(args[0], args[1], threshold);
+        else if (!gen.empty())
+            return scale(args[0], args[1], gen, sizes, runs, timeout);
+        else
+            return bench(args[0], args[1], runs, warmup, timeout, filter);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 2;
+    }
+}
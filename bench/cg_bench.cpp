@@ -0,0 +1,137 @@
+#include "solver.h"
+#include "smart_type.h"
+#include "predicate.h"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+// the micro-benchmarks of the operations performed by the causal-graph solver on atoms, independent of any search:
+//
+//     lucy_cg_bench [--min-time seconds] [--filter substring]
+//
+// every benchmark reads a problem with 'n' facts of a predicate having a bool, a real and an object parameter, and, then, measures either the pairwise unification tests among the facts or the construction of the listeners of the facts..
+// as any solver, the benchmarks require the 'init.rddl' file into the working directory..
+
+using namespace cg;
+
+// a micro-benchmark: it prepares its input, runs its measured section and returns the time spent into the latter (in seconds), adding its counters to the given ones..
+typedef std::function<double(std::map<std::string, double> &counters)> micro_benchmark;
+
+template <typename F>
+double measure(const F &f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// a problem with 'n' facts, whose parameters take a few distinct values, so that some of the facts unify..
+std::string facts_problem(const size_t &n)
+{
+    std::string s = "class Obj { bool b; real r; Obj(bool b, real r) : b(b), r(r) {} }\n"
+                    "predicate P(bool b, real r, Obj o) {}\n";
+    for (size_t i = 0; i < 10; ++i)
+        s += "Obj o" + std::to_string(i) + " = new Obj(" + (i % 2 ? "true" : "false") + ", " + std::to_string(i % 7) + ".0);\n";
+    for (size_t i = 0; i < n; ++i)
+        s += "fact f" + std::to_string(i) + " = new P(b:" + (i % 2 ? "true" : "false") + ", r:" + std::to_string(i % 5) + ".0, o:o" + std::to_string(i % 10) + ");\n";
+    return s;
+}
+
+std::vector<atom *> facts(solver &slv)
+{
+    std::vector<atom *> atms;
+    for (const auto &a : slv.get_predicate("P").get_instances())
+        atms.push_back(static_cast<atom *>(&*a));
+    return atms;
+}
+
+// the unification test (i.e., 'equates') of every pair of facts..
+micro_benchmark unify(const size_t &n)
+{
+    return [n](std::map<std::string, double> &counters) {
+        solver slv;
+        slv.init();
+        slv.read(facts_problem(n));
+        const std::vector<atom *> atms = facts(slv);
+        size_t n_unifiable = 0;
+        const double t = measure([&] {
+            for (const auto &a0 : atms)
+                for (const auto &a1 : atms)
+                    n_unifiable += a0->equates(*a1);
+        });
+        counters["tests"] += atms.size() * atms.size();
+        counters["unifiable"] += n_unifiable;
+        return t;
+    };
+}
+
+// the construction (and destruction) of a listener for every fact, as done by the smart types for each of their atoms..
+micro_benchmark listeners(const size_t &n)
+{
+    return [n](std::map<std::string, double> &counters) {
+        solver slv;
+        slv.init();
+        slv.read(facts_problem(n));
+        const std::vector<atom *> atms = facts(slv);
+        const double t = measure([&] {
+            for (const auto &a : atms)
+                delete new atom_listener(*a);
+        });
+        counters["listeners"] += atms.size();
+        return t;
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    double min_time = 0.5;
+    std::string filter;
+    std::vector<std::pair<std::string, micro_benchmark>> bs;
+    bs.push_back({"cg/unify/n:100", unify(100)});
+    bs.push_back({"cg/unify/n:300", unify(300)});
+    bs.push_back({"cg/atom_listener/n:100", listeners(100)});
+    bs.push_back({"cg/atom_listener/n:300", listeners(300)});
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (i + 1 < argc && arg == "--min-time")
+                min_time = std::stod(argv[++i]);
+            else if (i + 1 < argc && arg == "--filter")
+                filter = argv[++i];
+            else
+            {
+                std::cerr << "usage: lucy_cg_bench [--min-time seconds] [--filter substring]" << std::endl;
+                return 2;
+            }
+        }
+
+        std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "iterations" << std::setw(14) << "time (ms)"
+                  << "  counters (per second)" << std::endl;
+        for (const auto &b : bs)
+        {
+            if (b.first.find(filter) == std::string::npos)
+                continue;
+            size_t iterations = 0;
+            double total = 0;
+            std::map<std::string, double> counters;
+            while (total < min_time && iterations < 1000)
+            {
+                total += b.second(counters);
+                iterations++;
+            }
+            std::cout << std::left << std::setw(40) << b.first << std::right << std::setw(12) << iterations << std::setw(14) << std::fixed << std::setprecision(3) << total / iterations * 1000 << " ";
+            for (const auto &c : counters)
+                std::cout << " " << c.first << "=" << std::setprecision(0) << c.second / total;
+            std::cout << std::endl;
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,37 @@
+#include "generators.h"
+#include <iostream>
+
+// writes a generated problem on the standard output:
+//
+//     lucy_gen blocks <n>
+//     lucy_gen logistics <k> <m>
+//     lucy_gen sv <n>
+//     lucy_gen rr <n> <c>
+//
+// the blocks and the logistics problems have to be read along with the corresponding domains of the 'examples' folder..
+
+int main(int argc, char *argv[])
+{
+    const std::string kind = argc > 1 ? argv[1] : "";
+    try
+    {
+        if (kind == "blocks" && argc == 3)
+            std::cout << blocks_problem(std::stoul(argv[2]));
+        else if (kind == "logistics" && argc == 4)
+            std::cout << logistics_problem(std::stoul(argv[2]), std::stoul(argv[3]));
+        else if (kind == "sv" && argc == 3)
+            std::cout << state_variable_problem(std::stoul(argv[2]));
+        else if (kind == "rr" && argc == 4)
+            std::cout << reusable_resource_problem(std::stoul(argv[2]), std::stoul(argv[3]));
+        else
+        {
+            std::cerr << "usage: lucy_gen blocks <n> | logistics <k> <m> | sv <n> | rr <n> <c>" << std::endl;
+            return 2;
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,68 @@
+#include "generators.h"
+#include <sstream>
+
+std::string blocks_problem(const size_t &n)
+{
+    std::stringstream ss;
+    for (size_t i = 0; i < n; ++i)
+        ss << "Block b" << i << " = new Block(" << i + 1 << ".0);\n";
+    ss << "\nBlocksAgent agent = new BlocksAgent();\n\n";
+    for (size_t i = 0; i < n; ++i)
+    {
+        ss << "fact clear_b" << i << " = new agent.propositional_state.Clear(polarity:true, x:b" << i << ", start:origin); clear_b" << i << ".duration >= 1.0;\n";
+        ss << "fact ontable_b" << i << " = new agent.propositional_state.Ontable(polarity:true, x:b" << i << ", start:origin); ontable_b" << i << ".duration >= 1.0;\n";
+    }
+    ss << "fact handempty = new agent.propositional_state.Handempty(polarity:true, start:origin); handempty.duration >= 1.0;\n\n";
+    for (size_t i = 1; i < n; ++i)
+        ss << "goal on_b" << i << "_b" << i - 1 << " = new agent.propositional_state.On(polarity:true, x:b" << i << ", y:b" << i - 1 << ", end:horizon);\n";
+    return ss.str();
+}
+
+std::string logistics_problem(const size_t &k, const size_t &m)
+{
+    std::stringstream ss;
+    size_t id = 1;
+    ss << "Airplane apn = new Airplane(" << id++ << ".0);\n";
+    for (size_t i = 0; i < k; ++i)
+    {
+        ss << "Truck tru" << i << " = new Truck(" << id++ << ".0);\n";
+        ss << "Location pos" << i << " = new Location(" << id++ << ".0);\n";
+        ss << "Airport apt" << i << " = new Airport(" << id++ << ".0);\n";
+        ss << "City cit" << i << " = new City(" << id++ << ".0);\n";
+    }
+    for (size_t j = 0; j < m; ++j)
+        ss << "Package obj" << j << " = new Package(" << id++ << ".0);\n";
+    ss << "\nLogisticsAgent agent = new LogisticsAgent();\n\n";
+    ss << "fact _at_apn = new agent.propositional_state.At(polarity:true, obj:apn, l:apt0, start:origin); _at_apn.duration >= 1.0;\n";
+    for (size_t i = 0; i < k; ++i)
+    {
+        ss << "fact _at_tru" << i << " = new agent.propositional_state.At(polarity:true, obj:tru" << i << ", l:pos" << i << ", start:origin); _at_tru" << i << ".duration >= 1.0;\n";
+        ss << "fact in_city_pos" << i << " = new agent.propositional_state.In_city(polarity:true, l:pos" << i << ", c:cit" << i << ", start:origin); in_city_pos" << i << ".duration >= 1.0;\n";
+        ss << "fact in_city_apt" << i << " = new agent.propositional_state.In_city(polarity:true, l:apt" << i << ", c:cit" << i << ", start:origin); in_city_apt" << i << ".duration >= 1.0;\n";
+    }
+    for (size_t j = 0; j < m; ++j)
+        ss << "fact _at_obj" << j << " = new agent.propositional_state.At(polarity:true, obj:obj" << j << ", l:pos" << j % k << ", start:origin); _at_obj" << j << ".duration >= 1.0;\n";
+    ss << "\n";
+    for (size_t j = 0; j < m; ++j)
+        ss << "goal _at_obj" << j << "_apt = new agent.propositional_state.At(polarity:true, obj:obj" << j << ", l:apt" << (j + 1) % k << ", end:horizon);\n";
+    return ss.str();
+}
+
+std::string state_variable_problem(const size_t &n)
+{
+    std::stringstream ss;
+    ss << "class Machine : StateVariable {\n\n    predicate Busy() {\n        duration >= 1.0;\n    }\n}\n\n";
+    ss << "Machine m = new Machine();\n\n";
+    for (size_t i = 0; i < n; ++i)
+        ss << "fact t" << i << " = new m.Busy(); t" << i << ".start >= origin; t" << i << ".end <= horizon;\n";
+    return ss.str();
+}
+
+std::string reusable_resource_problem(const size_t &n, const size_t &c)
+{
+    std::stringstream ss;
+    ss << "ReusableResource rr = new ReusableResource(" << c << ".0);\n\n";
+    for (size_t i = 0; i < n; ++i)
+        ss << "fact u" << i << " = new rr.Use(amount:1.0, duration:2.0); u" << i << ".start >= origin; u" << i << ".end <= horizon;\n";
+    return ss.str();
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+// generators of parameterized (and arbitrarily large) problems, for stress benchmarking..
+// the blocks and the logistics problems require the corresponding domains of the 'examples' folder, the others are self-contained..
+
+std::string blocks_problem(const size_t &n);                       // 'n' blocks, initially on the table, which have to be stacked into a single tower..
+std::string logistics_problem(const size_t &k, const size_t &m);   // 'k' cities, each with a truck, a location and an airport, an airplane and 'm' packages, each to be moved to the airport of the next city..
+std::string state_variable_problem(const size_t &n);               // 'n' tokens contending the same state variable..
+std::string reusable_resource_problem(const size_t &n, const size_t &c); // 'n' unit uses of a reusable resource having capacity 'c'..
@@ -0,0 +1,306 @@
+#include "sat_core.h"
+#include "la_theory.h"
+#include "ov_theory.h"
+#include "sat_search.h"
+#include "dimacs.h"
+#include "smtlib_reader.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+
+// the micro-benchmarks of the smt-lib engines, independent of any RDDL parsing:
+//
+//     lucy_smt_bench [--min-time seconds] [--filter substring] [--json report.json] [cnf and smt2 files..]
+//
+// every benchmark is repeated (on the same, seeded, inputs) until the given time has been spent into its measured section, its counters are reported per second of measured time..
+// the given DIMACS CNF files and SMT-LIB2 scripts are solved as additional benchmarks, so as to compare the throughput of the engines with that of other solvers..
+
+using namespace smt;
+
+// a micro-benchmark: it prepares its input, runs its measured section and returns the time spent into the latter (in seconds), adding its counters to the given ones..
+typedef std::function<double(const size_t &it, std::map<std::string, double> &counters)> micro_benchmark;
+
+template <typename F>
+double measure(const F &f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void add_sat_counters(const sat_core &sat, std::map<std::string, double> &counters)
+{
+    counters["decisions"] += sat.n_decisions();
+    counters["propagations"] += sat.n_propagations();
+    counters["conflicts"] += sat.n_conflicts();
+}
+
+micro_benchmark random_3sat(const size_t &n, const double &ratio)
+{
+    return [n, ratio](const size_t &it, std::map<std::string, double> &counters) {
+        std::mt19937 gen(static_cast<unsigned>(it));
+        std::uniform_int_distribution<size_t> rnd_var(0, n - 1);
+        std::bernoulli_distribution rnd_sign;
+        sat_core sat;
+        std::vector<var> vars;
+        for (size_t i = 0; i < n; ++i)
+            vars.push_back(sat.new_var());
+        const size_t m = static_cast<size_t>(n * ratio);
+        bool consistent = true;
+        for (size_t i = 0; i < m && consistent; ++i)
+            consistent = sat.new_clause({lit(vars[rnd_var(gen)], rnd_sign(gen)), lit(vars[rnd_var(gen)], rnd_sign(gen)), lit(vars[rnd_var(gen)], rnd_sign(gen))});
+        sat_search search(sat);
+        bool res = false;
+        const double t = measure([&] { res = consistent && search.solve(); });
+        add_sat_counters(sat, counters);
+        counters["satisfiable"] += res;
+        return t;
+    };
+}
+
+micro_benchmark dimacs(const std::string &file)
+{
+    return [file](const size_t &, std::map<std::string, double> &counters) {
+        std::ifstream ifs(file);
+        if (!ifs)
+            throw std::invalid_argument("file not found: " + file);
+        sat_core sat;
+        dimacs_reader rdr(sat);
+        const bool consistent = rdr.read(ifs);
+        sat_search search(sat);
+        bool res = false;
+        const double t = measure([&] { res = consistent && search.solve(); });
+        add_sat_counters(sat, counters);
+        counters["satisfiable"] += res;
+        return t;
+    };
+}
+
+// an SMT-LIB2 script, whose responses are discarded..
+micro_benchmark smtlib(const std::string &file)
+{
+    return [file](const size_t &, std::map<std::string, double> &counters) {
+        std::ifstream ifs(file);
+        if (!ifs)
+            throw std::invalid_argument("file not found: " + file);
+        std::ostream null_os(nullptr);
+        sat_core sat;
+        la_theory la(sat);
+        smtlib_reader rdr(sat, la, null_os);
+        const double t = measure([&] { rdr.read(ifs); });
+        add_sat_counters(sat, counters);
+        counters["pivots"] += la.n_pivots();
+        return t;
+    };
+}
+
+// 'm' random difference constraints (i.e., 'x_i - x_j <= c') over 'n' variables, satisfied by a hidden solution..
+micro_benchmark la_difference(const size_t &n, const size_t &m)
+{
+    return [n, m](const size_t &it, std::map<std::string, double> &counters) {
+        std::mt19937 gen(static_cast<unsigned>(it));
+        std::uniform_int_distribution<size_t> rnd_var(0, n - 1);
+        std::uniform_int_distribution<I> rnd_val(0, 100);
+        std::uniform_int_distribution<I> rnd_slack(0, 5);
+        sat_core sat;
+        la_theory la(sat);
+        std::vector<var> xs;
+        std::vector<I> sol;
+        for (size_t i = 0; i < n; ++i)
+        {
+            xs.push_back(la.new_var());
+            sol.push_back(rnd_val(gen));
+        }
+        bool res = false;
+        const double t = measure([&] {
+            bool consistent = true;
+            for (size_t k = 0; k < m && consistent; ++k)
+            {
+                const size_t i = rnd_var(gen), j = rnd_var(gen);
+                if (i == j)
+                    continue;
+                consistent = sat.new_clause({lit(la.new_leq(lin(xs[i], rational::ONE) - lin(xs[j], rational::ONE), lin(rational(sol[i] - sol[j] + rnd_slack(gen)))), true)});
+            }
+            res = consistent && sat.check();
+        });
+        counters["pivots"] += la.n_pivots();
+        counters["satisfiable"] += res;
+        return t;
+    };
+}
+
+// 'm' random linear constraints, each over 'k' variables (out of 'n') with small non-zero coefficients, satisfied by a hidden solution (the rationals of the engine are 64-bit, hence larger instances easily overflow)..
+micro_benchmark la_general(const size_t &n, const size_t &m, const size_t &k)
+{
+    return [n, m, k](const size_t &it, std::map<std::string, double> &counters) {
+        std::mt19937 gen(static_cast<unsigned>(it));
+        std::uniform_int_distribution<size_t> rnd_var(0, n - 1);
+        std::uniform_int_distribution<I> rnd_val(0, 100);
+        std::uniform_int_distribution<I> rnd_coeff(1, 3);
+        std::bernoulli_distribution rnd_sign;
+        std::uniform_int_distribution<I> rnd_slack(0, 5);
+        sat_core sat;
+        la_theory la(sat);
+        std::vector<var> xs;
+        std::vector<I> sol;
+        for (size_t i = 0; i < n; ++i)
+        {
+            xs.push_back(la.new_var());
+            sol.push_back(rnd_val(gen));
+        }
+        bool res = false;
+        const double t = measure([&] {
+            bool consistent = true;
+            for (size_t c = 0; c < m && consistent; ++c)
+            {
+                lin l;
+                I val = 0;
+                for (size_t j = 0; j < k; ++j)
+                {
+                    const size_t x = rnd_var(gen);
+                    const I a = rnd_sign(gen) ? rnd_coeff(gen) : -rnd_coeff(gen);
+                    l += lin(xs[x], rational(a));
+                    val += a * sol[x];
+                }
+                const bool leq = c % 2 == 0;
+                const var ctr = leq ? la.new_leq(l, lin(rational(val + rnd_slack(gen)))) : la.new_geq(l, lin(rational(val - rnd_slack(gen))));
+                consistent = sat.new_clause({lit(ctr, true)});
+            }
+            res = consistent && sat.check();
+        });
+        counters["pivots"] += la.n_pivots();
+        counters["satisfiable"] += res;
+        return t;
+    };
+}
+
+// the equality between two object variables having 'n' allowed values (the second one allows only half of them), which is then assumed and propagated..
+micro_benchmark ov_eq(const size_t &n)
+{
+    return [n](const size_t &it, std::map<std::string, double> &counters) {
+        std::mt19937 gen(static_cast<unsigned>(it));
+        std::bernoulli_distribution rnd_in;
+        std::vector<var_value> vals(n);
+        std::unordered_set<var_value *> l_vals, r_vals;
+        for (auto &v : vals)
+        {
+            l_vals.insert(&v);
+            if (rnd_in(gen))
+                r_vals.insert(&v);
+        }
+        sat_core sat;
+        ov_theory ov(sat);
+        const var l = ov.new_var(l_vals), r = ov.new_var(r_vals);
+        bool res = false;
+        const double t = measure([&] {
+            const var eq = ov.eq(l, r);
+            res = sat.assume(lit(eq, true)) && sat.check();
+        });
+        counters["propagations"] += sat.n_propagations();
+        counters["satisfiable"] += res;
+        return t;
+    };
+}
+
+struct result
+{
+    std::string name;
+    size_t iterations;
+    double time; // the mean time of the measured section, in seconds..
+    std::map<std::string, double> rates;
+};
+
+result run(const std::string &name, const micro_benchmark &b, const double &min_time)
+{
+    result r;
+    r.name = name;
+    r.iterations = 0;
+    double total = 0;
+    std::map<std::string, double> counters;
+    while (total < min_time && r.iterations < 1000)
+        total += b(r.iterations++, counters);
+    r.time = total / r.iterations;
+    for (const auto &c : counters)
+        r.rates[c.first] = c.first == "satisfiable" ? c.second / r.iterations : c.second / total; // the satisfiable instances are reported as a fraction..
+    return r;
+}
+
+int main(int argc, char *argv[])
+{
+    double min_time = 0.5;
+    std::string filter;
+    std::string json;
+    std::vector<std::pair<std::string, micro_benchmark>> bs;
+    bs.push_back({"sat/random_3sat/n:50/r:4.26", random_3sat(50, 4.26)});
+    bs.push_back({"sat/random_3sat/n:100/r:4.26", random_3sat(100, 4.26)});
+    bs.push_back({"sat/random_3sat/n:5000/r:2.50", random_3sat(5000, 2.5)});
+    bs.push_back({"la/difference/n:50/m:200", la_difference(50, 200)});
+    bs.push_back({"la/difference/n:100/m:400", la_difference(100, 400)});
+    bs.push_back({"la/general/n:20/m:40/k:3", la_general(20, 40, 3)});
+    bs.push_back({"la/general/n:50/m:100/k:2", la_general(50, 100, 2)});
+    bs.push_back({"ov/eq/n:1000", ov_eq(1000)});
+    bs.push_back({"ov/eq/n:100000", ov_eq(100000)});
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (i + 1 < argc && arg == "--min-time")
+                min_time = std::stod(argv[++i]);
+            else if (i + 1 < argc && arg == "--filter")
+                filter = argv[++i];
+            else if (i + 1 < argc && arg == "--json")
+                json = argv[++i];
+            else if (arg.compare(0, 2, "--") == 0)
+            {
+                std::cerr << "usage: lucy_smt_bench [--min-time seconds] [--filter substring] [--json report.json] [cnf and smt2 files..]" << std::endl;
+                return 2;
+            }
+            else if (arg.size() > 5 && arg.compare(arg.size() - 5, 5, ".smt2") == 0)
+                bs.push_back({"smt/smtlib/" + arg, smtlib(arg)});
+            else
+                bs.push_back({"sat/dimacs/" + arg, dimacs(arg)});
+        }
+
+        std::vector<result> rs;
+        std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "iterations" << std::setw(14) << "time (ms)"
+                  << "  counters (per second)" << std::endl;
+        for (const auto &b : bs)
+        {
+            if (b.first.find(filter) == std::string::npos)
+                continue;
+            rs.push_back(run(b.first, b.second, min_time));
+            const result &r = rs.back();
+            std::cout << std::left << std::setw(40) << r.name << std::right << std::setw(12) << r.iterations << std::setw(14) << std::fixed << std::setprecision(3) << r.time * 1000 << " ";
+            for (const auto &c : r.rates)
+                std::cout << " " << c.first << "=" << std::setprecision(c.first == "satisfiable" ? 2 : 0) << c.second;
+            std::cout << std::endl;
+        }
+
+        if (!json.empty())
+        {
+            std::ofstream os(json);
+            os << std::fixed << std::setprecision(6) << "{ \"benchmarks\" : [";
+            for (std::vector<result>::const_iterator r_it = rs.begin(); r_it != rs.end(); ++r_it)
+            {
+                if (r_it != rs.begin())
+                    os << ", ";
+                os << "{ \"name\" : \"" << r_it->name << "\", \"iterations\" : " << r_it->iterations << ", \"time\" : " << r_it->time * 1000;
+                for (const auto &c : r_it->rates)
+                    os << ", \"" << c.first << "\" : " << c.second;
+                os << " }";
+            }
+            os << "] }" << std::endl;
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,36 @@
+#include "arena.h"
+
+namespace cg
+{
+
+arena::arena(const size_t &chunk_size) : chunk_size(chunk_size) {}
+
+arena::~arena()
+{
+    // we release all the chunks..
+    for (const auto &c : chunks)
+        delete[] c;
+}
+
+void *arena::allocate(size_t size)
+{
+    // we round the requested size, so that the next block is still suitably aligned..
+    size = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    if (size > c_left)
+    {
+        if (size > chunk_size / 4)
+        {
+            // large blocks get their own chunk, so as not to waste the rest of the current one..
+            chunks.push_back(new char[size]);
+            return chunks.back();
+        }
+        chunks.push_back(new char[chunk_size]);
+        c_ptr = chunks.back();
+        c_left = chunk_size;
+    }
+    void *ptr = c_ptr;
+    c_ptr += size;
+    c_left -= size;
+    return ptr;
+}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace cg
+{
+
+class arena
+{
+public:
+  arena(const size_t &chunk_size = 64 * 1024);
+  arena(const arena &orig) = delete;
+  virtual ~arena();
+
+  void *allocate(size_t size); // returns a block of (at least) the given size, suitably aligned for any object, which is released, in bulk, along with the arena..
+
+private:
+  const size_t chunk_size;    // the size of the (ordinary) chunks..
+  std::vector<char *> chunks; // the allocated chunks..
+  char *c_ptr = nullptr;      // the first free byte of the current chunk..
+  size_t c_left = 0;          // the free bytes of the current chunk..
+};
+}
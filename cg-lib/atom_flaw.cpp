@@ -1,5 +1,6 @@
 #include "atom_flaw.h"
 #include "solver.h"
+#include "atom_index.h"
 #include "predicate.h"
 #include <cassert>
 
@@ -39,13 +40,14 @@ void atom_flaw::compute_resolvers()
             q.pop();
         }
 
-        for (const auto &i : atm.tp.get_instances())
+        // we visit only those atoms which have already been expanded and whose fixed parameters do not prevent unification..
+        for (const auto &i : slv.get_index(static_cast<const predicate &>(atm.tp)).get_candidates(atm))
         {
-            if (&*i == &atm) // the current atom cannot unify with itself..
+            if (i == &atm) // the current atom cannot unify with itself..
                 continue;
 
             // this is the atom we are checking for unification..
-            atom &c_atm = static_cast<atom &>(*i);
+            atom &c_atm = *i;
 
             // this is the target flaw (i.e. the one we are checking for unification) and cannot be in the current flaw's causes' effects..
             atom_flaw &target = slv.get_flaw(c_atm);
@@ -64,25 +66,14 @@ void atom_flaw::compute_resolvers()
 
             // since atom 'c_atm' is a good candidate for unification, we build the unification literals..
             std::vector<lit> unif_lits;
-            q.push(this);
-            q.push(&target);
             unif_lits.push_back(lit(atm.sigma, false)); // we force the state of this atom to be 'unified' within the unification literals..
             unif_lits.push_back(c_atm.sigma);           // we force the state of the target atom to be 'active' within the unification literals..
-            std::unordered_set<const flaw *> seen;
-            while (!q.empty())
-            {
-                if (seen.find(q.front()) == seen.end())
-                {
-                    seen.insert(q.front()); // we avoid some repetition of literals..
-                    for (const auto &cause : q.front()->get_causes())
-                        if (slv.sat_cr.value(cause->get_rho()) != True)
-                        {
-                            unif_lits.push_back(cause->get_rho()); // we add the resolver's variable to the unification literals..
-                            q.push(&cause->get_effect());          // we push its effect..
-                        }
-                }
-                q.pop();
-            }
+            // the resolvers which have caused either of the two flaws are taken from their (cached) causal chains..
+            std::unordered_set<const resolver *> seen;
+            for (const auto &chain : {&get_causal_chain(), &target.get_causal_chain()})
+                for (const auto &cause : *chain)
+                    if (slv.sat_cr.value(cause->get_rho()) != True && seen.insert(cause).second)
+                        unif_lits.push_back(cause->get_rho()); // we add the resolver's variable to the unification literals..
 
             if (slv.sat_cr.value(eq_v) != True)
                 unif_lits.push_back(eq_v);
@@ -90,7 +81,7 @@ void atom_flaw::compute_resolvers()
             if (unif_lits.empty() || slv.sat_cr.check(unif_lits))
             {
                 // unification is actually possible!
-                unify_atom *u_res = new unify_atom(slv, *this, atm, c_atm, unif_lits);
+                unify_atom *u_res = new (slv) unify_atom(slv, *this, atm, c_atm, unif_lits);
                 assert(slv.sat_cr.value(u_res->get_rho()) != False);
                 add_resolver(*u_res);
                 slv.new_causal_link(target, *u_res);
@@ -100,17 +91,28 @@ void atom_flaw::compute_resolvers()
     }
 
     if (is_fact)
-        add_resolver(*new activate_fact(slv, *this, atm));
+        add_resolver(*new (slv) activate_fact(slv, *this, atm));
     else
-        add_resolver(*new activate_goal(slv, *this, atm));
+        add_resolver(*new (slv) activate_goal(slv, *this, atm));
+
+    // the atom can now be a target for the unification of other atoms, hence, we index it (along with all the super-predicates)..
+    std::queue<const predicate *> q;
+    q.push(&static_cast<const predicate &>(atm.tp));
+    while (!q.empty())
+    {
+        slv.get_index(*q.front()).add_atom(atm);
+        for (const auto &st : q.front()->get_supertypes())
+            q.push(static_cast<const predicate *>(st));
+        q.pop();
+    }
 }
 
-atom_flaw::activate_fact::activate_fact(solver &slv, atom_flaw &f, atom &a) : resolver(slv, lin(0), f), atm(a) {}
+atom_flaw::activate_fact::activate_fact(solver &slv, atom_flaw &f, atom &a) : resolver(slv, lin(0), f, ACTIVATION_RESOLVER), atm(a) {}
 atom_flaw::activate_fact::~activate_fact() {}
 
 void atom_flaw::activate_fact::apply() { slv.sat_cr.new_clause({lit(rho, false), atm.sigma}); }
 
-atom_flaw::activate_goal::activate_goal(solver &slv, atom_flaw &f, atom &a) : resolver(slv, lin(1), f), atm(a) {}
+atom_flaw::activate_goal::activate_goal(solver &slv, atom_flaw &f, atom &a) : resolver(slv, lin(1), f, ACTIVATION_RESOLVER), atm(a) {}
 atom_flaw::activate_goal::~activate_goal() {}
 
 void atom_flaw::activate_goal::apply()
@@ -119,7 +121,7 @@ void atom_flaw::activate_goal::apply()
     static_cast<const predicate &>(atm.tp).apply_rule(atm);
 }
 
-atom_flaw::unify_atom::unify_atom(solver &slv, atom_flaw &f, atom &atm, atom &trgt, const std::vector<lit> &unif_lits) : resolver(slv, lin(1), f), atm(atm), trgt(trgt), unif_lits(unif_lits) {}
+atom_flaw::unify_atom::unify_atom(solver &slv, atom_flaw &f, atom &atm, atom &trgt, const std::vector<lit> &unif_lits) : resolver(slv, lin(1), f, UNIFICATION_RESOLVER), atm(atm), trgt(trgt), unif_lits(unif_lits) {}
 atom_flaw::unify_atom::~unify_atom() {}
 
 void atom_flaw::unify_atom::apply()
@@ -0,0 +1,144 @@
+#include "atom_index.h"
+#include "solver.h"
+#include <algorithm>
+
+#define MAX_KEY_DEPTH 4
+
+namespace cg
+{
+
+inline void combine(size_t &seed, const size_t &h) { seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2); }
+
+atom_index::atom_index(solver &slv, const predicate &pred) : slv(slv)
+{
+    // we index the same fields which are checked by the 'equates' method..
+    std::queue<const type *> q;
+    q.push(&pred);
+    while (!q.empty())
+    {
+        for (const auto &f : q.front()->get_fields())
+            if (!f.second->synthetic)
+                fields.push_back(f.second);
+        for (const auto &st : q.front()->get_supertypes())
+            q.push(st);
+        q.pop();
+    }
+    idxs.resize(fields.size());
+}
+
+atom_index::~atom_index() {}
+
+void atom_index::add_atom(atom &atm)
+{
+    atoms.push_back(&atm);
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        size_t key;
+        // values fixed at root level cannot change anymore, while the others might be retracted through backtracking..
+        if (slv.sat_cr.root_level() && get_key(fields[i]->tp, *atm.get(fields[i]->name), key))
+            idxs[i].vals[key].push_back(&atm);
+        else
+            idxs[i].any.push_back(&atm);
+    }
+}
+
+std::vector<atom *> atom_index::get_candidates(const atom &atm) const
+{
+    // we look for the most selective among the fields whose value is fixed for the given atom..
+    const field_index *c_idx = nullptr;
+    const std::vector<atom *> *c_vals = nullptr;
+    size_t c_size = atoms.size();
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        size_t key;
+        if (get_key(fields[i]->tp, *atm.get(fields[i]->name), key))
+        {
+            const auto at_key = idxs[i].vals.find(key);
+            const std::vector<atom *> *vals = at_key != idxs[i].vals.end() ? &at_key->second : nullptr;
+            size_t size = idxs[i].any.size() + (vals ? vals->size() : 0);
+            if (size < c_size)
+            {
+                c_idx = &idxs[i];
+                c_vals = vals;
+                c_size = size;
+            }
+        }
+    }
+
+    std::vector<atom *> cands;
+    if (c_idx)
+    {
+        cands.reserve(c_size);
+        if (c_vals)
+            cands.insert(cands.end(), c_vals->begin(), c_vals->end());
+        cands.insert(cands.end(), c_idx->any.begin(), c_idx->any.end());
+    }
+    else // no field can be used for filtering the candidates..
+        cands = atoms;
+    // atoms are visited in the same order they have been created (i.e., the order of their sigma variables)..
+    std::sort(cands.begin(), cands.end(), [](atom *a0, atom *a1) { return a0->sigma < a1->sigma; });
+    return cands;
+}
+
+bool atom_index::get_key(const type &tp, const item &itm, size_t &key, const unsigned &depth) const
+{
+    switch (itm.kind)
+    {
+    case BOOL_ITEM:
+        switch (slv.sat_cr.value(static_cast<const bool_item &>(itm).l))
+        {
+        case True:
+            key = TRUE_var;
+            return true;
+        case False:
+            key = FALSE_var;
+            return true;
+        default:
+            return false;
+        }
+    case ARITH_ITEM:
+    {
+        const lin &l = static_cast<const arith_item &>(itm).l;
+        const inf_rational lb = slv.la_th.lb(l);
+        if (!(lb == slv.la_th.ub(l))) // notice that infinite bounds cannot be compared through the '<' operator..
+            return false;
+        key = std::hash<I>()(lb.get_rational().numerator());
+        combine(key, std::hash<I>()(lb.get_rational().denominator()));
+        combine(key, std::hash<I>()(lb.get_infinitesimal().numerator()));
+        combine(key, std::hash<I>()(lb.get_infinitesimal().denominator()));
+        return true;
+    }
+    case VAR_ITEM:
+    {
+        std::unordered_set<var_value *> vals = slv.ov_th.value(static_cast<const var_item &>(itm).ev);
+        return vals.size() == 1 && get_key(tp, *static_cast<item *>(*vals.begin()), key, depth);
+    }
+    case STRING_ITEM:
+        return false;
+    default:
+    {
+        if (depth == MAX_KEY_DEPTH)
+            return false;
+        // objects are compared through their fields, hence, so are their keys..
+        key = 0;
+        std::queue<const type *> q;
+        q.push(&tp);
+        while (!q.empty())
+        {
+            for (const auto &f : q.front()->get_fields())
+                if (!f.second->synthetic)
+                {
+                    size_t f_key;
+                    if (!get_key(f.second->tp, *itm.get(f.first), f_key, depth + 1))
+                        return false;
+                    combine(key, f_key);
+                }
+            for (const auto &st : q.front()->get_supertypes())
+                q.push(st);
+            q.pop();
+        }
+        return true;
+    }
+    }
+}
+}
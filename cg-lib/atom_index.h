@@ -0,0 +1,40 @@
+#pragma once
+
+#include "atom.h"
+#include "predicate.h"
+#include "field.h"
+#include <unordered_map>
+
+using namespace lucy;
+
+namespace cg
+{
+
+class solver;
+
+class atom_index
+{
+public:
+  atom_index(solver &slv, const predicate &pred);
+  atom_index(const atom_index &orig) = delete;
+  virtual ~atom_index();
+
+  void add_atom(atom &atm);                                  // adds the given atom to the index..
+  std::vector<atom *> get_candidates(const atom &atm) const; // returns, in creation order, the indexed atoms which might unify with the given atom..
+
+private:
+  bool get_key(const type &tp, const item &itm, size_t &key, const unsigned &depth = 0) const; // computes the key of the given item, returns false if the value of the item is not fixed..
+
+private:
+  struct field_index
+  {
+    std::unordered_map<size_t, std::vector<atom *>> vals; // for each key, the atoms having a value with that key..
+    std::vector<atom *> any;                              // the atoms whose value was not fixed when they have been indexed..
+  };
+
+  solver &slv;
+  std::vector<const field *> fields; // the indexed fields..
+  std::vector<field_index> idxs;     // for each indexed field, its index..
+  std::vector<atom *> atoms;         // all the indexed atoms..
+};
+}
@@ -23,7 +23,7 @@ void disjunction_flaw::compute_resolvers()
     for (const auto &cnj : disj.get_conjunctions())
     {
         context cnj_ctx(new env(slv, ctx));
-        add_resolver(*new choose_conjunction(slv, *this, cnj_ctx, *cnj));
+        add_resolver(*new (slv) choose_conjunction(slv, *this, cnj_ctx, *cnj));
     }
 }
 
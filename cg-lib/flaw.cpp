@@ -12,7 +12,14 @@ flaw::flaw(solver &slv, const std::vector<resolver *> &causes, const bool &exclu
         r->preconditions.push_back(this);
 }
 
-flaw::~flaw() {}
+flaw::~flaw()
+{
+    // flaws own their resolvers..
+    for (const auto &r : resolvers)
+        delete r;
+}
+
+void *flaw::operator new(size_t size, solver &slv) { return slv.mem.allocate(size); }
 
 double flaw::get_cost() const
 {
@@ -27,6 +34,23 @@ void flaw::init()
 {
     assert(!expanded);
 
+    // we collect the causal chain of this flaw, in breadth-first order..
+    if (causes.size() == 1)
+    {
+        causal_chain.reserve(causes[0]->effect.causal_chain.size() + 1);
+        causal_chain.push_back(causes[0]);
+        causal_chain.insert(causal_chain.end(), causes[0]->effect.causal_chain.begin(), causes[0]->effect.causal_chain.end());
+    }
+    else if (causes.size() > 1)
+    {
+        std::unordered_set<resolver *> seen(causes.begin(), causes.end());
+        causal_chain.insert(causal_chain.end(), causes.begin(), causes.end());
+        for (const auto &c : causes)
+            for (const auto &r : c->effect.causal_chain)
+                if (seen.insert(r).second)
+                    causal_chain.push_back(r);
+    }
+
     if (causes.empty())
         // the flaw is necessarily active..
         phi = TRUE_var;
@@ -20,11 +20,16 @@ public:
   flaw(const flaw &orig) = delete;
   virtual ~flaw();
 
+  static void *operator new(size_t size, solver &slv); // flaws are allocated into the arena of their solver..
+  static void operator delete(void *, solver &) {}
+  static void operator delete(void *) {} // the memory of the flaws is released, in bulk, along with their solver..
+
   bool is_expanded() const { return expanded; }
   const var &get_phi() const { return phi; }
   std::vector<resolver *> get_resolvers() const { return resolvers; }
   std::vector<resolver *> get_causes() const { return causes; }
   std::vector<resolver *> get_supports() const { return supports; }
+  const std::vector<resolver *> &get_causal_chain() const { return causal_chain; } // returns the resolvers which have, either directly or indirectly, caused this flaw..
   double get_cost() const;
 
   virtual std::string get_label() const = 0;
@@ -44,9 +49,10 @@ private:
   const bool exclusive;
   const bool structural;
   bool expanded = false;
-  var phi;                           // the propositional variable indicates whether the flaw is active or not..
-  std::vector<resolver *> resolvers; // the resolvers for this flaw..
-  std::vector<resolver *> causes;    // the causes for having this flaw..
-  std::vector<resolver *> supports;  // the resolvers supported by this flaw..
+  var phi;                              // the propositional variable indicates whether the flaw is active or not..
+  std::vector<resolver *> resolvers;    // the resolvers for this flaw..
+  std::vector<resolver *> causes;       // the causes for having this flaw..
+  std::vector<resolver *> supports;     // the resolvers supported by this flaw..
+  std::vector<resolver *> causal_chain; // the causes of this flaw along with the causes of their effects (causes never change, so we compute them just once)..
 };
 }
\ No newline at end of file
@@ -25,11 +25,16 @@ void propositional_agent::new_goal(atom_flaw &f)
     atom &atm = f.get_atom();
     atoms.push_back({&atm, new agnt_atom_listener(*this, atm)});
     to_check.insert(&atm);
+    set_dirty();
 }
 
 propositional_agent::agnt_atom_listener::agnt_atom_listener(propositional_agent &agnt, atom &atm) : atom_listener(atm), agnt(agnt) {}
 propositional_agent::agnt_atom_listener::~agnt_atom_listener() {}
-void propositional_agent::agnt_atom_listener::something_changed() { agnt.to_check.insert(&atm); }
+void propositional_agent::agnt_atom_listener::something_changed()
+{
+    agnt.to_check.insert(&atm);
+    agnt.set_dirty();
+}
 
 propositional_agent::agnt_flaw::agnt_flaw(solver &s, const std::set<atom *> &overlapping_atoms) : flaw(s, smart_type::get_resolvers(s, overlapping_atoms)), overlapping_atoms(overlapping_atoms) {}
 propositional_agent::agnt_flaw::~agnt_flaw() {}
@@ -43,6 +43,7 @@ void propositional_state::new_fact(atom_flaw &f)
 
     atoms.push_back({&atm, new ps_atom_listener(*this, atm)});
     to_check.insert(&atm);
+    set_dirty();
 }
 
 void propositional_state::new_goal(atom_flaw &f)
@@ -50,6 +51,7 @@ void propositional_state::new_goal(atom_flaw &f)
     atom &atm = f.get_atom();
     atoms.push_back({&atm, new ps_atom_listener(*this, atm)});
     to_check.insert(&atm);
+    set_dirty();
 }
 
 propositional_state::ps_predicate::ps_predicate(propositional_state &ps) : predicate(ps.slv, ps, PROPOSITIONAL_STATE_PREDICATE_NAME, {new field(ps.slv.get_type("bool"), PROPOSITIONAL_STATE_POLARITY_NAME)}, {}) { supertypes.push_back(&ps.slv.get_predicate("IntervalPredicate")); }
@@ -57,7 +59,11 @@ propositional_state::ps_predicate::~ps_predicate() {}
 
 propositional_state::ps_atom_listener::ps_atom_listener(propositional_state &ps, atom &atm) : atom_listener(atm), ps(ps) {}
 propositional_state::ps_atom_listener::~ps_atom_listener() {}
-void propositional_state::ps_atom_listener::something_changed() { ps.to_check.insert(&atm); }
+void propositional_state::ps_atom_listener::something_changed()
+{
+    ps.to_check.insert(&atm);
+    ps.set_dirty();
+}
 
 propositional_state::ps_flaw::ps_flaw(solver &s, const std::set<atom *> &overlapping_atoms) : flaw(s, smart_type::get_resolvers(s, overlapping_atoms)), overlapping_atoms(overlapping_atoms) {}
 propositional_state::ps_flaw::~ps_flaw() {}
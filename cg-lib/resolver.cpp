@@ -5,10 +5,12 @@
 namespace cg
 {
 
-resolver::resolver(solver &slv, const var &r, const lin &cost, flaw &eff) : slv(slv), rho(r), cost(cost), effect(eff) { assert(slv.la_th.value(cost).get_infinitesimal() == rational::ZERO); }
-resolver::resolver(solver &slv, const lin &cost, flaw &eff) : resolver(slv, slv.sat_cr.new_var(), cost, eff) {}
+resolver::resolver(solver &slv, const var &r, const lin &cost, flaw &eff, const resolver_kind &kind) : kind(kind), slv(slv), rho(r), cost(cost), effect(eff) { assert(slv.la_th.value(cost).get_infinitesimal() == rational::ZERO); }
+resolver::resolver(solver &slv, const lin &cost, flaw &eff, const resolver_kind &kind) : resolver(slv, slv.sat_cr.new_var(), cost, eff, kind) {}
 resolver::~resolver() {}
 
+void *resolver::operator new(size_t size, solver &slv) { return slv.mem.allocate(size); }
+
 void resolver::init()
 {
     if (slv.sat_cr.value(rho) == Undefined) // we do not have a top-level (a landmark) resolver..
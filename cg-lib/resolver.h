@@ -11,17 +11,28 @@ namespace cg
 class solver;
 class flaw;
 
+enum resolver_kind
+{
+  ACTIVATION_RESOLVER,  // an 'atom_flaw::activate_fact' or an 'atom_flaw::activate_goal'..
+  UNIFICATION_RESOLVER, // an 'atom_flaw::unify_atom'..
+  OTHER_RESOLVER        // any other resolver..
+};
+
 class resolver
 {
   friend class solver;
   friend class flaw;
 
 public:
-  resolver(solver &slv, const var &r, const lin &cost, flaw &eff);
-  resolver(solver &slv, const lin &cost, flaw &eff);
+  resolver(solver &slv, const var &r, const lin &cost, flaw &eff, const resolver_kind &kind = OTHER_RESOLVER);
+  resolver(solver &slv, const lin &cost, flaw &eff, const resolver_kind &kind = OTHER_RESOLVER);
   resolver(const resolver &orig) = delete;
   virtual ~resolver();
 
+  static void *operator new(size_t size, solver &slv); // resolvers are allocated into the arena of their solver..
+  static void operator delete(void *, solver &) {}
+  static void operator delete(void *) {} // the memory of the resolvers is released, in bulk, along with their solver..
+
 private:
   void init();
   virtual void apply() = 0;
@@ -34,6 +45,9 @@ public:
 
   virtual std::string get_label() const = 0;
 
+public:
+  const resolver_kind kind; // the kind of the resolver..
+
 protected:
   solver &slv;                                               // the solver this resolver belongs to..
   const var rho;                                             // the propositional variable indicating whether the resolver is active or not..
@@ -2,6 +2,7 @@
 #include "combinations.h"
 #include "statement.h"
 #include "expression.h"
+#include <algorithm>
 
 namespace cg
 {
@@ -22,65 +23,64 @@ std::vector<flaw *> reusable_resource::get_flaws()
         return flaws;
     else
     {
-        // we collect atoms for each state variable..
-        std::unordered_map<item *, std::vector<atom *>> rr_instances;
-        for (const auto &a : atoms)
-            if (slv.sat_cr.value(a.first->sigma) == True) // we filter out those which are not strictly active..
-            {
-                expr c_scope = a.first->get(TAU);
-                if (var_item *enum_scope = dynamic_cast<var_item *>(&*c_scope))
-                {
-                    for (const auto &val : slv.ov_th.value(enum_scope->ev))
-                        if (to_check.find(static_cast<item *>(val)) != to_check.end())
-                            rr_instances[static_cast<item *>(val)].push_back(a.first);
-                }
-                else
-                    rr_instances[static_cast<item *>(&*c_scope)].push_back(a.first);
-            }
+        // we bring the resource profiles up to date..
+        for (const auto &l : to_update)
+            update_events(*l);
+        to_update.clear();
 
-        for (const auto &rr : rr_instances)
+        for (const auto &rr : to_check)
         {
-            // for each pulse, the atoms starting at that pulse..
-            std::map<inf_rational, std::set<atom *>> starting_atoms;
-            // for each pulse, the atoms ending at that pulse..
-            std::map<inf_rational, std::set<atom *>> ending_atoms;
-            // all the pulses of the timeline..
-            std::set<inf_rational> pulses;
-            // the resource capacity..
-            arith_expr capacity = rr.first->get(REUSABLE_RESOURCE_CAPACITY);
+            const auto at_rr = profiles.find(rr);
+            if (at_rr == profiles.end())
+                continue;
 
-            for (const auto &a : rr.second)
-            {
-                arith_expr s_expr = a->get("start");
-                arith_expr e_expr = a->get("end");
-                inf_rational start = slv.la_th.value(s_expr->l);
-                inf_rational end = slv.la_th.value(e_expr->l);
-                starting_atoms[start].insert(a);
-                ending_atoms[end].insert(a);
-                pulses.insert(start);
-                pulses.insert(end);
-            }
-
-            std::set<atom *> overlapping_atoms;
-            for (const auto &p : pulses)
+            // the resource capacity..
+            arith_expr capacity = rr->get(REUSABLE_RESOURCE_CAPACITY);
+            inf_rational c_capacity = slv.la_th.value(capacity->l);
+
+            // we sweep the profile, pulse by pulse, keeping track of the overlapping atoms (through their starting events) and of their resource usage..
+            const std::vector<rr_event> &evs = at_rr->second;
+            std::vector<const rr_event *> overlapping_atoms;
+            inf_rational resource_usage;
+            bool peak = false; // whether the overlapping atoms exceed the capacity and have not been reported yet..
+            size_t i = 0;
+            while (i < evs.size())
             {
-                const auto at_start_p = starting_atoms.find(p);
-                if (at_start_p != starting_atoms.end())
-                    overlapping_atoms.insert(at_start_p->second.begin(), at_start_p->second.end());
-                const auto at_end_p = ending_atoms.find(p);
-                if (at_end_p != ending_atoms.end())
-                    for (const auto &a : at_end_p->second)
-                        overlapping_atoms.erase(a);
-                lin resource_usage;
-                for (const auto &a : overlapping_atoms)
-                {
-                    arith_expr amount = a->get(REUSABLE_RESOURCE_USE_AMOUNT_NAME);
-                    resource_usage += amount->l;
-                }
-
-                if (slv.la_th.value(resource_usage) > slv.la_th.value(capacity->l)) // we have a peak..
-                    flaws.push_back(new rr_flaw(slv, overlapping_atoms));
+                const inf_rational &p = evs[i].pulse;
+                size_t j = i;
+                for (; j < evs.size() && evs[j].pulse == p; ++j)
+                    if (peak && !evs[j].starting && slv.sat_cr.value(evs[j].atm->sigma) == True && std::any_of(overlapping_atoms.begin(), overlapping_atoms.end(), [&](const rr_event *e) { return e->atm == evs[j].atm; }))
+                    { // the current peak is about to decrease, hence, it is a local maximum which we report..
+                        report_peak(overlapping_atoms, c_capacity, flaws);
+                        peak = false;
+                    }
+
+                bool changed = false;
+                for (; i < j; ++i)
+                    if (slv.sat_cr.value(evs[i].atm->sigma) == True) // we filter out those which are not strictly active..
+                    {
+                        changed = true;
+                        if (evs[i].starting)
+                        {
+                            overlapping_atoms.push_back(&evs[i]);
+                            resource_usage += evs[i].amount;
+                        }
+                        else
+                        {
+                            const auto at_atm = std::find_if(overlapping_atoms.begin(), overlapping_atoms.end(), [&](const rr_event *e) { return e->atm == evs[i].atm; });
+                            if (at_atm != overlapping_atoms.end())
+                            {
+                                overlapping_atoms.erase(at_atm);
+                                resource_usage -= evs[i].amount;
+                            }
+                        }
+                    }
+
+                if (changed)
+                    peak = resource_usage > c_capacity; // we have a peak..
             }
+            if (peak)
+                report_peak(overlapping_atoms, c_capacity, flaws);
         }
 
         to_check.clear();
@@ -88,6 +88,75 @@ std::vector<flaw *> reusable_resource::get_flaws()
     }
 }
 
+void reusable_resource::report_peak(const std::vector<const rr_event *> &overlapping_atoms, const inf_rational &capacity, std::vector<flaw *> &flaws)
+{
+    // we extract a minimal critical set by taking the largest uses first: removing any of its atoms brings the usage within the capacity..
+    std::vector<const rr_event *> c_atoms(overlapping_atoms);
+    std::stable_sort(c_atoms.begin(), c_atoms.end(), [](const rr_event *e0, const rr_event *e1) { return e0->amount > e1->amount; });
+    std::set<atom *> mcs;
+    inf_rational c_usage;
+    for (const auto &e : c_atoms)
+    {
+        mcs.insert(e->atm);
+        c_usage += e->amount;
+        if (c_usage > capacity)
+            break;
+    }
+    // a flaw for this critical set might have already been created (either in this check or in a previous one), in which case it would share its phi variable with the new one..
+    if (rr_flaws.find(mcs) == rr_flaws.end())
+    {
+        rr_flaw *f = new (slv) rr_flaw(slv, mcs);
+        rr_flaws.insert({mcs, f});
+        flaws.push_back(f);
+    }
+}
+
+void reusable_resource::update_events(rr_atom_listener &l)
+{
+    l.to_update = false;
+
+    std::vector<item *> c_scopes;
+    expr c_scope = l.atm.get(TAU);
+    if (c_scope->kind == VAR_ITEM)
+        for (const auto &val : slv.ov_th.value(static_cast<var_item &>(*c_scope).ev))
+            c_scopes.push_back(static_cast<item *>(val));
+    else
+        c_scopes.push_back(&*c_scope);
+    arith_expr s_expr = l.atm.get("start");
+    arith_expr e_expr = l.atm.get("end");
+    arith_expr a_expr = l.atm.get(REUSABLE_RESOURCE_USE_AMOUNT_NAME);
+    inf_rational c_start = slv.la_th.value(s_expr->l);
+    inf_rational c_end = slv.la_th.value(e_expr->l);
+    inf_rational c_amount = slv.la_th.value(a_expr->l);
+    bool moved = !(c_start == l.start) || !(c_end == l.end) || !(c_amount == l.amount);
+
+    // we remove the outdated events..
+    for (const auto &sc : l.scopes)
+        if (moved || std::find(c_scopes.begin(), c_scopes.end(), sc) == c_scopes.end())
+        {
+            std::vector<rr_event> &evs = profiles.at(sc);
+            for (const auto &e : {rr_event{l.start, l.amount, true, &l.atm}, rr_event{l.end, l.amount, false, &l.atm}})
+            {
+                const auto rng = std::equal_range(evs.begin(), evs.end(), e);
+                evs.erase(std::find_if(rng.first, rng.second, [&](const rr_event &c_e) { return c_e.atm == &l.atm; }));
+            }
+        }
+
+    // we add the new events..
+    for (const auto &sc : c_scopes)
+        if (moved || std::find(l.scopes.begin(), l.scopes.end(), sc) == l.scopes.end())
+        {
+            std::vector<rr_event> &evs = profiles[sc];
+            for (const auto &e : {rr_event{c_start, c_amount, true, &l.atm}, rr_event{c_end, c_amount, false, &l.atm}})
+                evs.insert(std::upper_bound(evs.begin(), evs.end(), e), e);
+        }
+
+    l.scopes = std::move(c_scopes);
+    l.start = c_start;
+    l.end = c_end;
+    l.amount = c_amount;
+}
+
 void reusable_resource::new_fact(atom_flaw &f)
 {
     // we apply interval-predicate if the fact becomes active..
@@ -101,12 +170,14 @@ void reusable_resource::new_fact(atom_flaw &f)
         throw unsolvable_exception();
 
     atoms.push_back({&atm, new rr_atom_listener(*this, atm)});
+    to_update.push_back(atoms.back().second);
     expr c_scope = atm.get(TAU);
-    if (var_item *enum_scope = dynamic_cast<var_item *>(&*c_scope))
-        for (const auto &val : slv.ov_th.value(enum_scope->ev))
+    if (c_scope->kind == VAR_ITEM)
+        for (const auto &val : slv.ov_th.value(static_cast<var_item &>(*c_scope).ev))
             to_check.insert(static_cast<item *>(val));
     else
         to_check.insert(&*c_scope);
+    set_dirty();
 }
 
 void reusable_resource::new_goal(atom_flaw &) { throw std::logic_error("it is not possible to define goals on a reusable resource.."); }
@@ -122,12 +193,18 @@ reusable_resource::rr_atom_listener::~rr_atom_listener() {}
 
 void reusable_resource::rr_atom_listener::something_changed()
 {
+    if (!to_update)
+    {
+        to_update = true;
+        rr.to_update.push_back(this);
+    }
     expr c_scope = atm.get(TAU);
-    if (var_item *enum_scope = dynamic_cast<var_item *>(&*c_scope))
-        for (const auto &val : atm.get_core().ov_th.value(enum_scope->ev))
+    if (c_scope->kind == VAR_ITEM)
+        for (const auto &val : atm.get_core().ov_th.value(static_cast<var_item &>(*c_scope).ev))
             rr.to_check.insert(static_cast<item *>(val));
     else
         rr.to_check.insert(&*c_scope);
+    rr.set_dirty();
 }
 
 reusable_resource::rr_flaw::rr_flaw(solver &slv, const std::set<atom *> &atms) : flaw(slv, smart_type::get_resolvers(slv, atms)), overlapping_atoms(atms) {}
@@ -135,37 +212,32 @@ reusable_resource::rr_flaw::~rr_flaw() {}
 
 void reusable_resource::rr_flaw::compute_resolvers()
 {
-    std::vector<std::vector<atom *>> cs = combinations(std::vector<atom *>(overlapping_atoms.begin(), overlapping_atoms.end()), 2);
-    for (const auto &as : cs)
-    {
-        arith_expr a0_start = as[0]->get("start");
-        arith_expr a0_end = as[0]->get("end");
-        arith_expr a1_start = as[1]->get("start");
-        arith_expr a1_end = as[1]->get("end");
+    // the atoms form a minimal critical set, hence, ordering any pair of them reduces the peak..
+    for_each_pair(std::vector<atom *>(overlapping_atoms.begin(), overlapping_atoms.end()), [&](atom *a0, atom *a1) {
+        arith_expr a0_start = a0->get("start");
+        arith_expr a0_end = a0->get("end");
+        arith_expr a1_start = a1->get("start");
+        arith_expr a1_end = a1->get("end");
 
         bool_expr a0_before_a1 = slv.leq(a0_end, a1_start);
         if (slv.sat_cr.value(a0_before_a1->l) != False)
-            add_resolver(*new order_resolver(slv, lin(), *this, *as[0], *as[1], a0_before_a1->l));
+            add_resolver(*new (slv) order_resolver(slv, lin(), *this, *a0, *a1, a0_before_a1->l));
         bool_expr a1_before_a0 = slv.leq(a1_end, a0_start);
         if (slv.sat_cr.value(a1_before_a0->l) != False)
-            add_resolver(*new order_resolver(slv, lin(), *this, *as[1], *as[0], a1_before_a0->l));
+            add_resolver(*new (slv) order_resolver(slv, lin(), *this, *a1, *a0, a1_before_a0->l));
+    });
 
-        expr a0_scope = as[0]->get(TAU);
-        if (var_item *enum_scope = dynamic_cast<var_item *>(&*a0_scope))
-        {
-            std::unordered_set<var_value *> a0_scopes = slv.ov_th.value(enum_scope->ev);
-            if (a0_scopes.size() > 1)
-                for (const auto &sc : a0_scopes)
-                    add_resolver(*new displace_resolver(slv, lin(), *this, *as[0], *static_cast<item *>(sc), lit(slv.ov_th.allows(enum_scope->ev, *sc), false)));
-        }
-
-        expr a1_scope = as[1]->get(TAU);
-        if (var_item *enum_scope = dynamic_cast<var_item *>(&*a1_scope))
+    // displacing any of the atoms reduces the peak as well (we consider each atom just once, rather than once for each pair)..
+    for (const auto &a : overlapping_atoms)
+    {
+        expr a_scope = a->get(TAU);
+        if (a_scope->kind == VAR_ITEM)
         {
-            std::unordered_set<var_value *> a1_scopes = slv.ov_th.value(enum_scope->ev);
-            if (a1_scopes.size() > 1)
-                for (const auto &sc : a1_scopes)
-                    add_resolver(*new displace_resolver(slv, lin(), *this, *as[1], *static_cast<item *>(sc), lit(slv.ov_th.allows(enum_scope->ev, *sc), false)));
+            var_item *enum_scope = static_cast<var_item *>(&*a_scope);
+            std::unordered_set<var_value *> a_scopes = slv.ov_th.value(enum_scope->ev);
+            if (a_scopes.size() > 1)
+                for (const auto &sc : a_scopes)
+                    add_resolver(*new (slv) displace_resolver(slv, lin(), *this, *a, *static_cast<item *>(sc), lit(slv.ov_th.allows(enum_scope->ev, *sc), false)));
         }
     }
 }
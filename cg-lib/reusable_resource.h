@@ -46,6 +46,8 @@ private:
 
   class rr_atom_listener : public atom_listener
   {
+    friend class reusable_resource;
+
   public:
     rr_atom_listener(reusable_resource &rr, atom &atm);
     rr_atom_listener(rr_atom_listener &&) = delete;
@@ -60,8 +62,27 @@ private:
 
   protected:
     reusable_resource &rr;
+
+  private:
+    bool to_update = true;      // whether the events of the atom must be updated..
+    std::vector<item *> scopes; // the resource instances in whose profiles the atom has been indexed..
+    inf_rational start, end;    // the pulses at which the atom has been indexed..
+    inf_rational amount;        // the amount of resource the atom has been indexed with..
+  };
+
+  struct rr_event
+  {
+    inf_rational pulse;  // the pulse of the event..
+    inf_rational amount; // the amount of resource used by the atom..
+    bool starting;       // whether the atom starts (rather than ends) at the pulse..
+    atom *atm;           // the atom which starts, or ends, at the pulse..
+
+    bool operator<(const rr_event &e) const { return pulse < e.pulse || (pulse == e.pulse && starting && !e.starting); } // events are sorted by pulse, starting events come first..
   };
 
+  void update_events(rr_atom_listener &l);                                                                                            // moves the events of the atom of the given listener according to its current scope, pulses and amount..
+  void report_peak(const std::vector<const rr_event *> &overlapping_atoms, const inf_rational &capacity, std::vector<flaw *> &flaws); // creates a flaw for a minimal critical set of the given peak, unless it has already been created..
+
   class rr_flaw : public flaw
   {
   public:
@@ -126,7 +147,10 @@ private:
   };
 
 private:
-  std::set<item *> to_check;
+  std::set<item *> to_check;                                  // the resource instances whose profile has changed since the last check..
+  std::vector<rr_atom_listener *> to_update;                  // the listeners whose atoms' events have to be updated..
+  std::unordered_map<item *, std::vector<rr_event>> profiles; // for each resource instance, its usage events sorted by pulse (starting ones first)..
+  std::map<std::set<atom *>, rr_flaw *> rr_flaws;             // the already created flaws, for each minimal critical set..
   std::vector<std::pair<atom *, rr_atom_listener *>> atoms;
 };
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ class smart_type : public type
   friend class solver;
 
 public:
-  smart_type(solver &slv, scope &scp, const std::string &name) : type(slv, scp, name, false), slv(slv) {}
+  smart_type(solver &slv, scope &scp, const std::string &name) : type(slv, scp, name, false, true), slv(slv) {}
   smart_type(const smart_type &that) = delete;
 
   virtual ~smart_type() {}
@@ -33,16 +33,27 @@ public:
     std::unordered_set<resolver *> ress;
     for (const auto &atm : atms)
       for (const auto &r : slv.get_flaw(*atm).get_resolvers())
-        if (resolver *af = dynamic_cast<atom_flaw::activate_fact *>(r))
-          ress.insert(af);
-        else if (resolver *ag = dynamic_cast<atom_flaw::activate_goal *>(r))
-          ress.insert(ag);
+        if (r->kind == ACTIVATION_RESOLVER)
+          ress.insert(r);
 
     return std::vector<resolver *>(ress.begin(), ress.end());
   }
 
+protected:
+  void set_dirty() // notifies the solver that this type might have some new inconsistency..
+  {
+    if (!dirty)
+    {
+      dirty = true;
+      slv.dirty_types.push_back(this);
+    }
+  }
+
 protected:
   solver &slv;
+
+private:
+  bool dirty = false; // whether this type has changed since the last inconsistency check..
 };
 
 class atom_listener : public sat_value_listener, public la_value_listener, public ov_value_listener
@@ -58,13 +69,21 @@ public:
         if (!f.second->synthetic)
         {
           item *i = &*atm.get(f.first);
-          if (bool_item *be = dynamic_cast<bool_item *>(i))
-            listen_sat(be->l.v);
-          else if (arith_item *ae = dynamic_cast<arith_item *>(i))
-            for (const auto &term : ae->l.vars)
+          switch (i->kind)
+          {
+          case BOOL_ITEM:
+            listen_sat(static_cast<bool_item *>(i)->l.v);
+            break;
+          case ARITH_ITEM:
+            for (const auto &term : static_cast<arith_item *>(i)->l.vars)
               listen_la(term.first);
-          else if (var_item *ee = dynamic_cast<var_item *>(i))
-            listen_set(ee->ev);
+            break;
+          case VAR_ITEM:
+            listen_set(static_cast<var_item *>(i)->ev);
+            break;
+          default:
+            break;
+          }
         }
 
       for (const auto &st : q.front()->get_supertypes())
@@ -1,7 +1,9 @@
 #include "solver.h"
+#include "domain.h"
 #include "enum_flaw.h"
 #include "disjunction_flaw.h"
 #include "atom_flaw.h"
+#include "atom_index.h"
 #include "smart_type.h"
 #include "state_variable.h"
 #include "reusable_resource.h"
@@ -19,18 +21,90 @@
 namespace cg
 {
 
-solver::solver() : core(), theory(sat_cr) {}
-solver::~solver() {}
+// a flat JSON object, built one member at a time..
+class json_object
+{
+public:
+    json_object &add(const char *key, const size_t &n) { return add_member(key, std::to_string(n)); }
+    json_object &add(const char *key, const double &d) { return add_member(key, std::to_string(d)); }
+    json_object &add(const char *key, const json_object &obj) { return add_member(key, obj.str()); }
+
+    std::string str() const { return members.empty() ? "{ }" : "{ " + members + " }"; }
+
+private:
+    json_object &add_member(const char *key, const std::string &val)
+    {
+        if (!members.empty())
+            members += ", ";
+        members += '"';
+        members += key;
+        members += "\" : ";
+        members += val;
+        return *this;
+    }
+
+private:
+    std::string members;
+};
+
+// adds, on destruction, the elapsed time to the given duration..
+struct stopwatch
+{
+    stopwatch(std::chrono::steady_clock::duration &d) : d(d), start(std::chrono::steady_clock::now()) {}
+    ~stopwatch() { d += std::chrono::steady_clock::now() - start; }
+
+    std::chrono::steady_clock::duration &d;
+    const std::chrono::steady_clock::time_point start;
+};
+
+solver::solver() : core(), theory(sat_cr)
+{
+    // the graph is never left half-built, hence, the sat core is interrupted only while searching..
+    sat_cr.set_interrupt([this]() { return !building_graph && is_interrupted(); });
+}
+solver::~solver()
+{
+    // we delete the flaws (and, hence, their resolvers)..
+    for (const auto &f : all_flaws)
+        delete f;
+
+    // we delete the unification indexes..
+    for (const auto &idx : indexes)
+        delete idx.second;
+}
 
 void solver::init()
 {
-    read(std::vector<std::string>({"init.rddl"}));
+    // the initialization script is parsed just once and is, then, shared among all the solvers..
+    static const domain init_dom(std::vector<std::string>({"init.rddl"}));
+    read(init_dom);
     types.insert({STATE_VARIABLE_NAME, new state_variable(*this)});
     types.insert({REUSABLE_RESOURCE_NAME, new reusable_resource(*this)});
     types.insert({PROPOSITIONAL_AGENT_NAME, new propositional_agent(*this)});
     types.insert({PROPOSITIONAL_STATE_NAME, new propositional_state(*this)});
 }
 
+void solver::read(const std::string &script)
+{
+    stopwatch sw(parse_time);
+    store_decisions();
+    core::read(script);
+}
+
+void solver::read(const std::vector<std::string> &files)
+{
+    stopwatch sw(parse_time);
+    store_decisions();
+    core::read(files);
+}
+
+void solver::read(const domain &dom)
+{
+    stopwatch sw(parse_time);
+    store_decisions();
+    core::read(dom);
+}
+
 expr solver::new_enum(const type &tp, const std::unordered_set<item *> &allowed_vals)
 {
     assert(!allowed_vals.empty());
@@ -39,7 +113,7 @@ expr solver::new_enum(const type &tp, const std::unordered_set<item *> &allowed_
     if (allowed_vals.size() > 1)
     {
         // we create a new enum flaw..
-        enum_flaw *ef = new enum_flaw(*this, res, *c_e);
+        enum_flaw *ef = new (*this) enum_flaw(*this, res, *c_e);
         new_flaw(*ef);
     }
     return c_e;
@@ -48,7 +122,7 @@ expr solver::new_enum(const type &tp, const std::unordered_set<item *> &allowed_
 void solver::new_fact(atom &atm)
 {
     // we create a new atom flaw representing a fact..
-    atom_flaw *af = new atom_flaw(*this, res, atm, true);
+    atom_flaw *af = new (*this) atom_flaw(*this, res, atm, true);
     reason.insert({&atm, af});
     new_flaw(*af);
 
@@ -58,8 +132,8 @@ void solver::new_fact(atom &atm)
         q.push(static_cast<type *>(&atm.tp.get_scope()));
         while (!q.empty())
         {
-            if (smart_type *st = dynamic_cast<smart_type *>(q.front()))
-                st->new_fact(*af);
+            if (q.front()->smart)
+                static_cast<smart_type *>(q.front())->new_fact(*af);
             for (const auto &st : q.front()->get_supertypes())
                 q.push(st);
             q.pop();
@@ -70,7 +144,7 @@ void solver::new_fact(atom &atm)
 void solver::new_goal(atom &atm)
 {
     // we create a new atom flaw representing a goal..
-    atom_flaw *af = new atom_flaw(*this, res, atm, false);
+    atom_flaw *af = new (*this) atom_flaw(*this, res, atm, false);
     reason.insert({&atm, af});
     new_flaw(*af);
 
@@ -80,8 +154,8 @@ void solver::new_goal(atom &atm)
         q.push(static_cast<type *>(&atm.tp.get_scope()));
         while (!q.empty())
         {
-            if (smart_type *st = dynamic_cast<smart_type *>(q.front()))
-                st->new_goal(*af);
+            if (q.front()->smart)
+                static_cast<smart_type *>(q.front())->new_goal(*af);
             for (const auto &st : q.front()->get_supertypes())
                 q.push(st);
             q.pop();
@@ -92,64 +166,79 @@ void solver::new_goal(atom &atm)
 void solver::new_disjunction(context &d_ctx, const disjunction &disj)
 {
     // we create a new disjunction flaw..
-    disjunction_flaw *df = new disjunction_flaw(*this, res, d_ctx, disj);
+    disjunction_flaw *df = new (*this) disjunction_flaw(*this, res, d_ctx, disj);
     new_flaw(*df);
 }
 
 void solver::solve()
 {
-    // we build the causal graph..
-    build();
-
-    while (sat_cr.root_level())
+    stopwatch sw(solve_time);
+    steps = 0;
+    // if a solution has already been found, we start over from it..
+    store_decisions();
+    try
     {
-        assert(sat_cr.value(gamma) == False);
-        // we have exhausted the search within the graph: we extend the graph..
-        add_layer();
-    }
+        // we build the causal graph (or, if a solution has already been found, we complete it with the newly read flaws)..
+        build();
 
-    while (true)
-    {
-        // this is the next flaw to be solved..
-        flaw *f_next = select_flaw();
+        if (!to_replay.empty())
+        {
+            // we restore the previous solution, so that only the part affected by the newly read flaws has to be repaired..
+            std::vector<resolver *> decisions;
+            std::swap(decisions, to_replay);
+            replay(decisions);
+        }
+
+        restore_graph();
 
-        if (f_next)
+        while (true)
         {
+            if (is_interrupted())
+                throw interrupted_exception();
+
+            // this is the next flaw to be solved..
+            flaw *f_next = select_flaw();
+
+            if (f_next)
+            {
 #ifndef NDEBUG
-            std::cout << "(" << std::to_string(trail.size()) << "): " << f_next->get_label();
+                std::cout << "(" << std::to_string(trail.size()) << "): " << f_next->get_label();
 #endif
-            assert(f_next->get_cost() < std::numeric_limits<double>::infinity());
-            if (!f_next->structural || !has_inconsistencies()) // we run out of inconsistencies, thus, we renew them..
-            {
-                // this is the next resolver to be assumed..
-                res = &select_resolver(*f_next);
+                assert(f_next->get_cost() < std::numeric_limits<double>::infinity());
+                if (!f_next->structural || !has_inconsistencies()) // we run out of inconsistencies, thus, we renew them..
+                {
+                    // this is the next resolver to be assumed..
+                    res = &select_resolver(*f_next);
 #ifndef NDEBUG
-                std::cout << " " << res->get_label() << std::endl;
+                    std::cout << " " << res->get_label() << std::endl;
 #endif
 
-                // we apply the resolver..
-                if (!sat_cr.assume(res->rho) || !sat_cr.check())
-                    throw unsolvable_exception();
+                    // we apply the resolver..
+                    steps++;
+                    if (!sat_cr.assume(res->rho) || !sat_cr.check())
+                        throw unsolvable_exception();
 
-                res = nullptr;
-                while (sat_cr.root_level())
-                    if (sat_cr.value(gamma) == Undefined)
-                    {
-                        // we have learnt a unit clause! thus, we reassume the graph var..
-                        if (!sat_cr.assume(gamma) || !sat_cr.check())
-                            throw unsolvable_exception();
-                    }
-                    else
-                    {
-                        assert(sat_cr.value(gamma) == False);
-                        // we have exhausted the search within the graph: we extend the graph..
-                        add_layer();
-                    }
+                    res = nullptr;
+                    if (sat_cr.root_level())
+                        n_root_backtracks++;
+                    restore_graph();
+                }
+            }
+            else if (!has_inconsistencies()) // we run out of flaws, we check for inconsistencies one last time..
+            {
+                // Hurray!! we have found a solution..
+                if (solution_callback)
+                    solution_callback(*this);
+                return;
             }
         }
-        else if (!has_inconsistencies()) // we run out of flaws, we check for inconsistencies one last time..
-            // Hurray!! we have found a solution..
-            return;
+    }
+    catch (const interrupted_exception &)
+    {
+        // we keep the current partial solution, so that a later call can resume the search from it..
+        res = nullptr;
+        store_decisions();
+        throw;
     }
 }
 
@@ -158,16 +247,22 @@ void solver::build()
 #ifndef NDEBUG
     std::cout << "building the causal graph.." << std::endl;
 #endif
+    stopwatch sw(build_time);
     assert(sat_cr.root_level());
 
     while (std::any_of(flaws.begin(), flaws.end(), [&](flaw *f) { return f->get_cost() == std::numeric_limits<double>::infinity(); }))
     {
         if (flaw_q.empty())
             throw unsolvable_exception();
+        if (is_interrupted()) // the graph is left consistent, hence, a later call can continue its construction..
+            throw interrupted_exception();
         assert(!flaw_q.front()->expanded);
         if (sat_cr.value(flaw_q.front()->phi) != False)
             if (is_deferrable(*flaw_q.front())) // we postpone the expansion..
+            {
                 flaw_q.push_back(flaw_q.front());
+                n_deferred++;
+            }
             else // we expand the flaw..
                 expand_flaw(*flaw_q.front());
         flaw_q.pop_front();
@@ -186,6 +281,23 @@ void solver::build()
         throw unsolvable_exception();
 }
 
+void solver::restore_graph()
+{
+    while (sat_cr.root_level())
+        if (sat_cr.value(gamma) == Undefined)
+        {
+            // we have learnt a unit clause! thus, we reassume the graph var..
+            if (!sat_cr.assume(gamma) || !sat_cr.check())
+                throw unsolvable_exception();
+        }
+        else
+        {
+            assert(sat_cr.value(gamma) == False);
+            // we have exhausted the search within the graph: we extend the graph..
+            add_layer();
+        }
+}
+
 bool solver::is_deferrable(flaw &f)
 {
     std::queue<flaw *> q;
@@ -208,6 +320,8 @@ void solver::add_layer()
 #ifndef NDEBUG
     std::cout << "adding a layer to the causal graph.." << std::endl;
 #endif
+    stopwatch sw(build_time);
+    n_layers++;
     assert(sat_cr.root_level());
 
     std::list<flaw *> f_q(flaw_q);
@@ -216,11 +330,18 @@ void solver::add_layer()
         if (flaw_q.empty())
             throw unsolvable_exception();
         std::list<flaw *> c_q = std::move(flaw_q);
-        for (const auto &f : c_q)
+        while (!c_q.empty())
         {
-            assert(!f->expanded);
-            if (sat_cr.value(f->phi) != False) // we expand the flaw..
-                expand_flaw(*f);
+            if (is_interrupted())
+            {
+                // the flaws which have not been expanded yet are put back into the flaw queue, so that a later call can continue the construction of the graph..
+                flaw_q.splice(flaw_q.begin(), c_q);
+                throw interrupted_exception();
+            }
+            assert(!c_q.front()->expanded);
+            if (sat_cr.value(c_q.front()->phi) != False) // we expand the flaw..
+                expand_flaw(*c_q.front());
+            c_q.pop_front();
         }
     }
 
@@ -242,46 +363,43 @@ bool solver::has_inconsistencies()
 #ifndef NDEBUG
     std::cout << " (checking for inconsistencies..)";
 #endif
+    n_inc_checks++;
     std::vector<flaw *> incs;
-    std::queue<type *> q;
-    for (const auto &t : get_types())
-        if (!t.second->primitive)
-            q.push(t.second);
-
-    while (!q.empty())
+    // we visit only the smart types which have changed since the last check..
+    std::vector<smart_type *> c_types;
+    std::swap(c_types, dirty_types);
+    for (const auto &st : c_types)
     {
-        if (smart_type *st = dynamic_cast<smart_type *>(q.front()))
-        {
-            std::vector<flaw *> c_incs = st->get_flaws();
-            incs.insert(incs.end(), c_incs.begin(), c_incs.end());
-        }
-        for (const auto &st : q.front()->get_types())
-            q.push(st.second);
-        q.pop();
+        st->dirty = false;
+        std::vector<flaw *> c_incs = st->get_flaws();
+        // the new flaws are owned by the solver as soon as they have been constructed..
+        all_flaws.insert(all_flaws.end(), c_incs.begin(), c_incs.end());
+        incs.insert(incs.end(), c_incs.begin(), c_incs.end());
     }
 
     assert(std::none_of(incs.begin(), incs.end(), [&](flaw *f) { return f->structural; }));
     if (!incs.empty())
     {
         // we go back to root level..
-        while (!sat_cr.root_level())
-            sat_cr.pop();
+        backtrack_to_root();
 
-        // we initialize the new flaws..
-        for (const auto &f : incs)
         {
-            f->init();
+            // we initialize the new flaws..
+            stopwatch sw(build_time);
+            for (const auto &f : incs)
+            {
+                f->init();
 #ifdef BUILD_GUI
-            // we notify the listeners that a new flaw has arised..
-            for (const auto &l : listeners)
-                l->new_flaw(*f);
+                // we notify the listeners that a new flaw has arised..
+                for (const auto &l : listeners)
+                    l->new_flaw(*f);
 #endif
-            expand_flaw(*f);
+                expand_flaw(*f);
+            }
         }
 
         // we re-assume the current graph var to allow search within the current graph..
-        if (!sat_cr.assume(gamma) || !sat_cr.check())
-            throw unsolvable_exception();
+        restore_graph();
 #ifndef NDEBUG
         std::cout << ": " << std::to_string(incs.size()) << std::endl;
 #endif
@@ -291,8 +409,83 @@ bool solver::has_inconsistencies()
         return false;
 }
 
+bool solver::is_interrupted() const { return (stop_flag && stop_flag->load()) || steps >= step_budget || std::chrono::steady_clock::now() >= deadline; }
+
+std::string solver::get_statistics() const noexcept
+{
+    const auto ms = [](const std::chrono::steady_clock::duration &d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    json_object sat;
+    sat.add("vars", sat_cr.n_vars()).add("decisions", sat_cr.n_decisions()).add("propagations", sat_cr.n_propagations()).add("conflicts", sat_cr.n_conflicts()).add("learnts", sat_cr.n_learnts()).add("probes", sat_cr.n_probes());
+    json_object la;
+    la.add("pivots", la_th.n_pivots()).add("bound_updates", la_th.n_bound_updates()).add("checks", la_th.n_checks());
+    json_object cg;
+    cg.add("flaws", all_flaws.size()).add("expanded_flaws", n_expanded).add("deferred_flaws", n_deferred).add("layers", n_layers).add("inconsistency_checks", n_inc_checks).add("root_backtracks", n_root_backtracks);
+    json_object time;
+    time.add("parse", ms(parse_time)).add("build", ms(build_time)).add("search", ms(solve_time - build_time));
+    json_object stats;
+    stats.add("sat", sat).add("la", la).add("cg", cg).add("time", time);
+    return stats.str();
+}
+
+void solver::backtrack_to_root()
+{
+    if (!sat_cr.root_level())
+        n_root_backtracks++;
+    while (!sat_cr.root_level())
+        sat_cr.pop();
+}
+
+void solver::store_decisions()
+{
+    for (const auto &l : trail)
+        if (l.r)
+            to_replay.push_back(l.r);
+
+    // we go back to root level..
+    backtrack_to_root();
+}
+
+void solver::replay(const std::vector<resolver *> &decisions)
+{
+    auto r_it = decisions.begin();
+    try
+    {
+        // we re-assume the current graph var to allow search within the current graph..
+        restore_graph();
+        for (; r_it != decisions.end(); ++r_it)
+        {
+            if (sat_cr.root_level() || sat_cr.value((*r_it)->rho) == False)
+                break;
+            if (sat_cr.value((*r_it)->rho) == True) // the decision is now implied..
+                continue;
+            size_t c_level = sat_cr.decision_level();
+            res = *r_it;
+            if (!sat_cr.assume((*r_it)->rho) || !sat_cr.check())
+                throw unsolvable_exception();
+            res = nullptr;
+            if (sat_cr.decision_level() <= c_level) // the decision led to a conflict, hence, we let the search continue from here..
+                break;
+        }
+        // the remaining decisions, if any, are not consistent with the current graph..
+        r_it = decisions.end();
+        // a replayed decision might have led to learning a unit clause, hence, to going back to root level..
+        restore_graph();
+    }
+    catch (const interrupted_exception &)
+    {
+        // we store both the current decisions and those which have not been replayed yet, so that a later call can resume the search from all of them..
+        res = nullptr;
+        store_decisions();
+        for (; r_it != decisions.end(); ++r_it)
+            if (std::find(to_replay.begin(), to_replay.end(), *r_it) == to_replay.end())
+                to_replay.push_back(*r_it);
+        throw;
+    }
+}
+
 void solver::expand_flaw(flaw &f)
 {
+    n_expanded++;
     building_graph = true;
     // we expand the flaw..
     f.expand();
@@ -335,7 +528,8 @@ void solver::expand_flaw(flaw &f)
 
 void solver::new_flaw(flaw &f)
 {
-    f.init(); // flaws' initialization requires being at root-level..
+    all_flaws.push_back(&f); // the flaw is registered only once it has been fully constructed..
+    f.init();                // flaws' initialization requires being at root-level..
     flaw_q.push_back(&f);
 #ifdef BUILD_GUI
     // we notify the listeners that a new flaw has arised..
@@ -369,6 +563,19 @@ void solver::new_causal_link(flaw &f, resolver &r)
 #endif
 }
 
+atom_index &solver::get_index(const predicate &pred)
+{
+    const auto at_pred = indexes.find(&pred);
+    if (at_pred != indexes.end())
+        return *at_pred->second;
+    else
+    {
+        atom_index *idx = new atom_index(*this, pred);
+        indexes.insert({&pred, idx});
+        return *idx;
+    }
+}
+
 void solver::set_est_cost(resolver &r, const double &cst)
 {
     if (r.est_cost != cst)
@@ -397,12 +604,15 @@ void solver::set_est_cost(resolver &r, const double &cst)
             {
                 resolver &c_res = *resolver_q.front(); // the current resolver whose cost might require an update..
                 double r_cost = -std::numeric_limits<double>::infinity();
-                for (const auto &f : c_res.preconditions)
-                {
-                    double c = f->get_cost();
-                    if (c > r_cost)
-                        r_cost = c;
-                }
+                if (sat_cr.value(c_res.rho) == False) // removed resolvers cannot become cheaper..
+                    r_cost = std::numeric_limits<double>::infinity();
+                else
+                    for (const auto &f : c_res.preconditions)
+                    {
+                        double c = f->get_cost();
+                        if (c > r_cost)
+                            r_cost = c;
+                    }
                 if (c_res.est_cost != r_cost)
                 {
                     if (!trail.empty())
@@ -478,6 +688,9 @@ resolver &solver::select_resolver(flaw &f)
         }
     }
 
+    if (!r_next) // every resolver has been removed, or is not reachable within the current graph..
+        throw std::logic_error("the flaw " + f.get_label() + " has no applicable resolver..");
+
 #ifdef BUILD_GUI
     // we notify the listeners that we have selected a resolver..
     for (const auto &l : listeners)
@@ -508,13 +721,13 @@ bool solver::propagate(const lit &p, std::vector<lit> &cnfl)
                 }
                 else // this flaw has been removed from the current partial solution..
                     assert(flaws.find(f) == flaws.end());
-
-        const auto at_rhos_p = rhos.find(p.v);
-        if (at_rhos_p != rhos.end() && !p.sign) // a decision has been taken about the removal of some resolvers within the current partial solution..
-            for (const auto &r : at_rhos_p->second)
-                set_est_cost(*r, std::numeric_limits<double>::infinity());
     }
 
+    const auto at_rhos_p = rhos.find(p.v);
+    if (at_rhos_p != rhos.end() && !p.sign) // a decision has been taken about the removal of some resolvers (either within the current partial solution or while building the graph)..
+        for (const auto &r : at_rhos_p->second)
+            set_est_cost(*r, std::numeric_limits<double>::infinity());
+
     return true;
 }
 
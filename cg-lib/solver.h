@@ -1,6 +1,10 @@
 #pragma once
 
 #include "core.h"
+#include "arena.h"
+#include <chrono>
+#include <atomic>
+#include <functional>
 
 using namespace lucy;
 
@@ -9,7 +13,9 @@ namespace cg
 
 class flaw;
 class atom_flaw;
+class atom_index;
 class resolver;
+class smart_type;
 class cg_listener;
 
 class solver : public core, public theory
@@ -17,6 +23,7 @@ class solver : public core, public theory
   friend class flaw;
   friend class atom_flaw;
   friend class resolver;
+  friend class smart_type;
   friend class cg_listener;
 
 public:
@@ -26,6 +33,11 @@ public:
 
   void init(); // initializes the solver..
 
+  // the following methods can also be called once a solution has been found: the current plan is then repaired, rather than recomputed from scratch, by the next call to 'solve'..
+  void read(const std::string &script) override;
+  void read(const std::vector<std::string> &files) override;
+  void read(const domain &dom) override;
+
   expr new_enum(const type &tp, const std::unordered_set<item *> &allowed_vals) override;
 
 private:
@@ -34,7 +46,14 @@ private:
   void new_disjunction(context &d_ctx, const disjunction &disj) override;
 
 public:
-  void solve() override; // solves the given problem..
+  void solve() override; // solves the given problem, throws an 'interrupted_exception' if the search is interrupted (a later call resumes the search from the current partial solution)..
+
+  void set_deadline(const std::chrono::steady_clock::time_point &d) { deadline = d; }                 // the search is interrupted once the given time point has been reached..
+  void set_step_budget(const size_t &n) { step_budget = n; }                                          // the search is interrupted once the given number of resolvers has been applied within a single call to 'solve'..
+  void set_stop_flag(const std::atomic<bool> *const flag) { stop_flag = flag; }                       // the search is interrupted as soon as the given flag (which can be set by another thread) becomes true..
+  void set_solution_callback(const std::function<void(solver &)> &f) { solution_callback = f; }      // the given function is called whenever a solution is found..
+
+  std::string get_statistics() const noexcept; // returns a JSON description of the statistics collected so far..
 
   atom_flaw &get_flaw(const atom &atm) const { return *reason.at(&atm); } // returns the flaw which has given rise to the atom..
 
@@ -42,16 +61,25 @@ private:
   void build();                // builds the planning graph..
   bool is_deferrable(flaw &f); // checks whether the given flaw is deferrable..
   void add_layer();            // adds a layer to the current planning graph..
+  void restore_graph();        // if the search is at root level, re-assumes the graph var, extending the graph while its search space is exhausted..
   bool has_inconsistencies();  // checks whether the types have some inconsistency..
   void expand_flaw(flaw &f);   // expands the given flaw into the planning graph..
 
+  bool is_interrupted() const; // checks whether the search should be interrupted..
+
+  void backtrack_to_root();                              // goes back to root level, counting the backtrack..
+  void store_decisions();                                // stores the current decisions into 'to_replay' and goes back to root level..
+  void replay(const std::vector<resolver *> &decisions); // re-assumes the graph var and replays the given decisions, as long as they are consistent with the current graph, if interrupted, the decisions which have not been replayed yet are kept into 'to_replay'..
+
   void new_flaw(flaw &f);
   void new_resolver(resolver &r);
   void new_causal_link(flaw &f, resolver &r);
 
+  atom_index &get_index(const predicate &pred); // returns the unification index of the given predicate..
+
   void set_est_cost(resolver &r, const double &cst); // sets the estimated cost of the given resolver and propagates it to other resolvers..
   flaw *select_flaw();                               // selects the most expensive flaw from the 'flaws' set, returns a nullptr if there are no active flaws..
-  resolver &select_resolver(flaw &f);                // selects the least expensive resolver for the given flaw..
+  resolver &select_resolver(flaw &f);                // selects the least expensive resolver for the given flaw, throws an 'std::logic_error' if no resolver has a finite cost..
 
   bool propagate(const lit &p, std::vector<lit> &cnfl) override;
   bool check(std::vector<lit> &cnfl) override;
@@ -70,15 +98,34 @@ private:
     std::unordered_set<flaw *> solved_flaws;          // the just solved flaws..
   };
 
-  std::vector<cg_listener *> listeners;                  // the causal-graph listeners..
-  resolver *res = nullptr;                               // the current resolver (will be into the trail)..
-  var gamma;                                             // this variable represents the validity of the current graph..
-  bool building_graph = false;                           // we are either in a building graph phase or in a solving phase..
-  std::list<flaw *> flaw_q;                              // the flaw queue (for graph building procedure)..
-  std::unordered_set<flaw *> flaws;                      // the current active flaws..
-  std::unordered_map<var, std::vector<flaw *>> phis;     // the phi variables (boolean variable to flaws) of the flaws..
-  std::unordered_map<var, std::vector<resolver *>> rhos; // the rho variables (boolean variable to resolver) of the resolvers..
-  std::unordered_map<const atom *, atom_flaw *> reason;  // the reason for having introduced an atom..
-  std::vector<layer> trail;                              // the list of resolvers in chronological order..
+  arena mem;                                                   // the memory arena of flaws and resolvers..
+  std::vector<flaw *> all_flaws;                               // all the flaws created so far (along with their resolvers, they are destroyed along with the solver)..
+  std::vector<cg_listener *> listeners;                        // the causal-graph listeners..
+  resolver *res = nullptr;                                     // the current resolver (will be into the trail)..
+  var gamma;                                                   // this variable represents the validity of the current graph..
+  bool building_graph = false;                                 // we are either in a building graph phase or in a solving phase..
+  std::list<flaw *> flaw_q;                                    // the flaw queue (for graph building procedure)..
+  std::unordered_set<flaw *> flaws;                            // the current active flaws..
+  std::unordered_map<var, std::vector<flaw *>> phis;           // the phi variables (boolean variable to flaws) of the flaws..
+  std::unordered_map<var, std::vector<resolver *>> rhos;       // the rho variables (boolean variable to resolver) of the resolvers..
+  std::unordered_map<const atom *, atom_flaw *> reason;        // the reason for having introduced an atom..
+  std::unordered_map<const predicate *, atom_index *> indexes; // for each predicate, the index of its expanded atoms..
+  std::vector<smart_type *> dirty_types;                       // the smart types which have changed since the last inconsistency check..
+  std::vector<layer> trail;                                    // the list of resolvers in chronological order..
+  std::vector<resolver *> to_replay;                           // the decisions of the previous solution, to be replayed by the next call to 'solve'..
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(); // the time point at which the search is interrupted..
+  size_t step_budget = std::numeric_limits<size_t>::max();                                        // the maximum number of resolvers applied by a single call to 'solve'..
+  size_t steps = 0;                                                                               // the number of resolvers applied by the current call to 'solve'..
+  const std::atomic<bool> *stop_flag = nullptr;                                                   // an (optional) external cancellation flag..
+  std::function<void(solver &)> solution_callback;                                                // the (optional) function called whenever a solution is found..
+
+  size_t n_expanded = 0;                             // the number of expanded flaws..
+  size_t n_deferred = 0;                             // the number of times a flaw expansion has been deferred..
+  size_t n_layers = 0;                               // the number of layers added to the causal graph..
+  size_t n_inc_checks = 0;                           // the number of checks for inconsistencies..
+  size_t n_root_backtracks = 0;                      // the number of times the search went back to root level..
+  std::chrono::steady_clock::duration parse_time{0}; // the time spent reading problems..
+  std::chrono::steady_clock::duration build_time{0}; // the time spent building the causal graph..
+  std::chrono::steady_clock::duration solve_time{0}; // the time spent within 'solve' (including building the causal graph)..
 };
 }
\ No newline at end of file
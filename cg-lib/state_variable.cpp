@@ -1,6 +1,7 @@
 #include "state_variable.h"
 #include "predicate.h"
 #include "combinations.h"
+#include <algorithm>
 
 namespace cg
 {
@@ -21,57 +22,53 @@ std::vector<flaw *> state_variable::get_flaws()
         return flaws;
     else
     {
-        // we collect atoms for each state variable..
-        std::unordered_map<item *, std::vector<atom *>> sv_instances;
-        for (const auto &atm : atoms)
-            if (slv.sat_cr.value(atm.first->sigma) == True) // we filter out those which are not strictly active..
-            {
-                expr c_scope = atm.first->get(TAU);
-                if (var_item *enum_scope = dynamic_cast<var_item *>(&*c_scope))
-                {
-                    for (const auto &val : slv.ov_th.value(enum_scope->ev))
-                        if (to_check.find(static_cast<item *>(val)) != to_check.end())
-                            sv_instances[static_cast<item *>(val)].push_back(atm.first);
-                }
-                else
-                    sv_instances[static_cast<item *>(&*c_scope)].push_back(atm.first);
-            }
+        // we bring the timelines up to date..
+        for (const auto &l : to_update)
+            update_events(*l);
+        to_update.clear();
 
-        for (const auto &sv : sv_instances)
+        for (const auto &sv : to_check)
         {
-            // for each pulse, the atoms starting at that pulse..
-            std::map<inf_rational, std::set<atom *>> starting_atoms;
-            // for each pulse, the atoms ending at that pulse..
-            std::map<inf_rational, std::set<atom *>> ending_atoms;
-            // all the pulses of the timeline..
-            std::set<inf_rational> pulses;
-
-            for (const auto &atm : sv.second)
-            {
-                arith_expr s_expr = atm->get("start");
-                arith_expr e_expr = atm->get("end");
-                inf_rational start = slv.la_th.value(s_expr->l);
-                inf_rational end = slv.la_th.value(e_expr->l);
-                starting_atoms[start].insert(atm);
-                ending_atoms[end].insert(atm);
-                pulses.insert(start);
-                pulses.insert(end);
-            }
-
-            std::set<atom *> overlapping_atoms;
-            for (const auto &p : pulses)
+            const auto at_sv = timelines.find(sv);
+            if (at_sv == timelines.end())
+                continue;
+
+            // we sweep the timeline, pulse by pulse, keeping track of the overlapping atoms..
+            const std::vector<sv_event> &evs = at_sv->second;
+            std::vector<atom *> overlapping_atoms;
+            bool peak = false; // whether the overlapping atoms form a peak which has not been reported yet..
+            size_t i = 0;
+            while (i < evs.size())
             {
-                const auto at_start_p = starting_atoms.find(p);
-                if (at_start_p != starting_atoms.end())
-                    overlapping_atoms.insert(at_start_p->second.begin(), at_start_p->second.end());
-                const auto at_end_p = ending_atoms.find(p);
-                if (at_end_p != ending_atoms.end())
-                    for (const auto &a : at_end_p->second)
-                        overlapping_atoms.erase(a);
-
-                if (overlapping_atoms.size() > 1) // we have a peak..
-                    flaws.push_back(new sv_flaw(slv, overlapping_atoms));
+                const inf_rational &p = evs[i].pulse;
+                size_t j = i;
+                for (; j < evs.size() && evs[j].pulse == p; ++j)
+                    if (peak && !evs[j].starting && slv.sat_cr.value(evs[j].atm->sigma) == True && std::find(overlapping_atoms.begin(), overlapping_atoms.end(), evs[j].atm) != overlapping_atoms.end())
+                    { // the current peak is about to decrease, hence, it is a local maximum which we report (the previous overlapping sets are all included into this one)..
+                        report_peak(std::set<atom *>(overlapping_atoms.begin(), overlapping_atoms.end()), flaws);
+                        peak = false;
+                    }
+
+                bool changed = false;
+                for (; i < j; ++i)
+                    if (slv.sat_cr.value(evs[i].atm->sigma) == True) // we filter out those which are not strictly active..
+                    {
+                        changed = true;
+                        if (evs[i].starting)
+                            overlapping_atoms.push_back(evs[i].atm);
+                        else
+                        {
+                            const auto at_atm = std::find(overlapping_atoms.begin(), overlapping_atoms.end(), evs[i].atm);
+                            if (at_atm != overlapping_atoms.end())
+                                overlapping_atoms.erase(at_atm);
+                        }
+                    }
+
+                if (changed)
+                    peak = overlapping_atoms.size() > 1; // we have a peak..
             }
+            if (peak)
+                report_peak(std::set<atom *>(overlapping_atoms.begin(), overlapping_atoms.end()), flaws);
         }
 
         to_check.clear();
@@ -79,6 +76,60 @@ std::vector<flaw *> state_variable::get_flaws()
     }
 }
 
+void state_variable::report_peak(const std::set<atom *> &overlapping_atoms, std::vector<flaw *> &flaws)
+{
+    // a flaw for these atoms might have already been created (either in this check or in a previous one), in which case it would share its phi variable with the new one..
+    if (sv_flaws.find(overlapping_atoms) == sv_flaws.end())
+    {
+        sv_flaw *f = new (slv) sv_flaw(slv, overlapping_atoms);
+        sv_flaws.insert({overlapping_atoms, f});
+        flaws.push_back(f);
+    }
+}
+
+void state_variable::update_events(sv_atom_listener &l)
+{
+    l.to_update = false;
+
+    std::vector<item *> c_scopes;
+    expr c_scope = l.atm.get(TAU);
+    if (c_scope->kind == VAR_ITEM)
+        for (const auto &val : slv.ov_th.value(static_cast<var_item &>(*c_scope).ev))
+            c_scopes.push_back(static_cast<item *>(val));
+    else
+        c_scopes.push_back(&*c_scope);
+    arith_expr s_expr = l.atm.get("start");
+    arith_expr e_expr = l.atm.get("end");
+    inf_rational c_start = slv.la_th.value(s_expr->l);
+    inf_rational c_end = slv.la_th.value(e_expr->l);
+    bool moved = !(c_start == l.start) || !(c_end == l.end);
+
+    // we remove the outdated events..
+    for (const auto &sc : l.scopes)
+        if (moved || std::find(c_scopes.begin(), c_scopes.end(), sc) == c_scopes.end())
+        {
+            std::vector<sv_event> &evs = timelines.at(sc);
+            for (const auto &e : {sv_event{l.start, true, &l.atm}, sv_event{l.end, false, &l.atm}})
+            {
+                const auto rng = std::equal_range(evs.begin(), evs.end(), e);
+                evs.erase(std::find_if(rng.first, rng.second, [&](const sv_event &c_e) { return c_e.atm == &l.atm; }));
+            }
+        }
+
+    // we add the new events..
+    for (const auto &sc : c_scopes)
+        if (moved || std::find(l.scopes.begin(), l.scopes.end(), sc) == l.scopes.end())
+        {
+            std::vector<sv_event> &evs = timelines[sc];
+            for (const auto &e : {sv_event{c_start, true, &l.atm}, sv_event{c_end, false, &l.atm}})
+                evs.insert(std::upper_bound(evs.begin(), evs.end(), e), e);
+        }
+
+    l.scopes = std::move(c_scopes);
+    l.start = c_start;
+    l.end = c_end;
+}
+
 void state_variable::new_predicate(predicate &pred)
 {
     inherit(static_cast<predicate &>(slv.get_predicate("IntervalPredicate")), pred);
@@ -94,24 +145,28 @@ void state_variable::new_fact(atom_flaw &f)
     restore_var();
 
     atoms.push_back({&atm, new sv_atom_listener(*this, atm)});
+    to_update.push_back(atoms.back().second);
     expr c_scope = atm.get(TAU);
-    if (var_item *enum_scope = dynamic_cast<var_item *>(&*c_scope))
-        for (const auto &val : slv.ov_th.value(enum_scope->ev))
+    if (c_scope->kind == VAR_ITEM)
+        for (const auto &val : slv.ov_th.value(static_cast<var_item &>(*c_scope).ev))
             to_check.insert(static_cast<item *>(val));
     else
         to_check.insert(&*c_scope);
+    set_dirty();
 }
 
 void state_variable::new_goal(atom_flaw &f)
 {
     atom &atm = f.get_atom();
     atoms.push_back({&atm, new sv_atom_listener(*this, atm)});
+    to_update.push_back(atoms.back().second);
     expr c_scope = atm.get(TAU);
-    if (var_item *multi_scope = dynamic_cast<var_item *>(&*c_scope))
-        for (const auto &val : slv.ov_th.value(multi_scope->ev))
+    if (c_scope->kind == VAR_ITEM)
+        for (const auto &val : slv.ov_th.value(static_cast<var_item &>(*c_scope).ev))
             to_check.insert(static_cast<item *>(val));
     else
         to_check.insert(&*c_scope);
+    set_dirty();
 }
 
 state_variable::sv_atom_listener::sv_atom_listener(state_variable &sv, atom &atm) : atom_listener(atm), sv(sv) {}
@@ -119,12 +174,18 @@ state_variable::sv_atom_listener::~sv_atom_listener() {}
 
 void state_variable::sv_atom_listener::something_changed()
 {
+    if (!to_update)
+    {
+        to_update = true;
+        sv.to_update.push_back(this);
+    }
     expr c_scope = atm.get(TAU);
-    if (var_item *enum_scope = dynamic_cast<var_item *>(&*c_scope))
-        for (const auto &val : atm.get_core().ov_th.value(enum_scope->ev))
+    if (c_scope->kind == VAR_ITEM)
+        for (const auto &val : atm.get_core().ov_th.value(static_cast<var_item &>(*c_scope).ev))
             sv.to_check.insert(static_cast<item *>(val));
     else
         sv.to_check.insert(&*c_scope);
+    sv.set_dirty();
 }
 
 state_variable::sv_flaw::sv_flaw(solver &slv, const std::set<atom *> &atms) : flaw(slv, smart_type::get_resolvers(slv, atms)), overlapping_atoms(atms) {}
@@ -132,37 +193,31 @@ state_variable::sv_flaw::~sv_flaw() {}
 
 void state_variable::sv_flaw::compute_resolvers()
 {
-    std::vector<std::vector<atom *>> cs = combinations(std::vector<atom *>(overlapping_atoms.begin(), overlapping_atoms.end()), 2);
-    for (const auto &as : cs)
-    {
-        arith_expr a0_start = as[0]->get("start");
-        arith_expr a0_end = as[0]->get("end");
-        arith_expr a1_start = as[1]->get("start");
-        arith_expr a1_end = as[1]->get("end");
+    for_each_pair(std::vector<atom *>(overlapping_atoms.begin(), overlapping_atoms.end()), [&](atom *a0, atom *a1) {
+        arith_expr a0_start = a0->get("start");
+        arith_expr a0_end = a0->get("end");
+        arith_expr a1_start = a1->get("start");
+        arith_expr a1_end = a1->get("end");
 
         bool_expr a0_before_a1 = slv.leq(a0_end, a1_start);
         if (slv.sat_cr.value(a0_before_a1->l) != False)
-            add_resolver(*new order_resolver(slv, lin(), *this, *as[0], *as[1], a0_before_a1->l));
+            add_resolver(*new (slv) order_resolver(slv, lin(), *this, *a0, *a1, a0_before_a1->l));
         bool_expr a1_before_a0 = slv.leq(a1_end, a0_start);
         if (slv.sat_cr.value(a1_before_a0->l) != False)
-            add_resolver(*new order_resolver(slv, lin(), *this, *as[1], *as[0], a1_before_a0->l));
+            add_resolver(*new (slv) order_resolver(slv, lin(), *this, *a1, *a0, a1_before_a0->l));
+    });
 
-        expr a0_scope = as[0]->get(TAU);
-        if (var_item *enum_scope = dynamic_cast<var_item *>(&*a0_scope))
-        {
-            std::unordered_set<var_value *> a0_scopes = slv.ov_th.value(enum_scope->ev);
-            if (a0_scopes.size() > 1)
-                for (const auto &sc : a0_scopes)
-                    add_resolver(*new displace_resolver(slv, lin(), *this, *as[0], *static_cast<item *>(sc), lit(slv.ov_th.allows(enum_scope->ev, *sc), false)));
-        }
-
-        expr a1_scope = as[1]->get(TAU);
-        if (var_item *enum_scope = dynamic_cast<var_item *>(&*a0_scope))
+    // displacing any of the atoms solves the flaw as well (we consider each atom just once, rather than once for each pair)..
+    for (const auto &a : overlapping_atoms)
+    {
+        expr a_scope = a->get(TAU);
+        if (a_scope->kind == VAR_ITEM)
         {
-            std::unordered_set<var_value *> a1_scopes = slv.ov_th.value(enum_scope->ev);
-            if (a1_scopes.size() > 1)
-                for (const auto &sc : a1_scopes)
-                    add_resolver(*new displace_resolver(slv, lin(), *this, *as[1], *static_cast<item *>(sc), lit(slv.ov_th.allows(enum_scope->ev, *sc), false)));
+            var_item *enum_scope = static_cast<var_item *>(&*a_scope);
+            std::unordered_set<var_value *> a_scopes = slv.ov_th.value(enum_scope->ev);
+            if (a_scopes.size() > 1)
+                for (const auto &sc : a_scopes)
+                    add_resolver(*new (slv) displace_resolver(slv, lin(), *this, *a, *static_cast<item *>(sc), lit(slv.ov_th.allows(enum_scope->ev, *sc), false)));
         }
     }
 }
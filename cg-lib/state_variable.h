@@ -34,6 +34,8 @@ private:
 
   class sv_atom_listener : public atom_listener
   {
+    friend class state_variable;
+
   public:
     sv_atom_listener(state_variable &sv, atom &atm);
     sv_atom_listener(sv_atom_listener &&) = delete;
@@ -48,8 +50,25 @@ private:
 
   protected:
     state_variable &sv;
+
+  private:
+    bool to_update = true;      // whether the events of the atom must be updated..
+    std::vector<item *> scopes; // the state-variable instances in whose timelines the atom has been indexed..
+    inf_rational start, end;    // the pulses at which the atom has been indexed..
+  };
+
+  struct sv_event
+  {
+    inf_rational pulse; // the pulse of the event..
+    bool starting;      // whether the atom starts (rather than ends) at the pulse..
+    atom *atm;          // the atom which starts, or ends, at the pulse..
+
+    bool operator<(const sv_event &e) const { return pulse < e.pulse || (pulse == e.pulse && starting && !e.starting); } // events are sorted by pulse, starting events come first..
   };
 
+  void update_events(sv_atom_listener &l);                                                 // moves the events of the atom of the given listener according to its current scope and pulses..
+  void report_peak(const std::set<atom *> &overlapping_atoms, std::vector<flaw *> &flaws); // creates a flaw for the given peak, unless it has already been created..
+
   class sv_flaw : public flaw
   {
   public:
@@ -114,7 +133,10 @@ private:
   };
 
 private:
-  std::set<item *> to_check;
+  std::set<item *> to_check;                                   // the state-variable instances whose timeline has changed since the last check..
+  std::vector<sv_atom_listener *> to_update;                   // the listeners whose atoms' events have to be updated..
+  std::unordered_map<item *, std::vector<sv_event>> timelines; // for each state-variable instance, its events sorted by pulse (starting ones first)..
+  std::map<std::set<atom *>, sv_flaw *> sv_flaws;              // the already created flaws, for each set of overlapping atoms..
   std::vector<std::pair<atom *, sv_atom_listener *>> atoms;
 };
 }
\ No newline at end of file
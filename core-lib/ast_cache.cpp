@@ -0,0 +1,641 @@
+#include "ast_cache.h"
+#include "declaration.h"
+#include "statement.h"
+#include "expression.h"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#define CACHE_MAGIC "RDDLC"
+#define CACHE_VERSION 1
+
+namespace lucy
+{
+
+namespace ast
+{
+
+writer::writer(std::ostream &os) : os(os) {}
+writer::~writer() {}
+
+void writer::write_size(size_t n)
+{
+    while (n >= 0x80)
+    {
+        os.put(static_cast<char>((n & 0x7F) | 0x80));
+        n >>= 7;
+    }
+    os.put(static_cast<char>(n));
+}
+
+void writer::write_rational(const smt::rational &r)
+{
+    write_int(r.numerator());
+    write_int(r.denominator());
+}
+
+void writer::write_string(const std::string &str)
+{
+    const auto at_str = strings.find(str);
+    if (at_str != strings.end())
+        write_size(at_str->second);
+    else
+    { // a new string: its index is followed by its characters..
+        const size_t idx = strings.size();
+        strings.emplace(str, idx);
+        write_size(idx);
+        write_size(str.size());
+        os.write(str.data(), str.size());
+    }
+}
+
+void writer::write_ids(const std::vector<std::string> &ids)
+{
+    write_size(ids.size());
+    for (const auto &id : ids)
+        write_string(id);
+}
+
+void writer::write_parameters(const std::vector<std::pair<std::vector<std::string>, std::string>> &pars)
+{
+    write_size(pars.size());
+    for (const auto &par : pars)
+    {
+        write_ids(par.first);
+        write_string(par.second);
+    }
+}
+
+void writer::write_expression(const expression *const e)
+{
+    if (e)
+        e->write(*this);
+    else
+        write_kind(NULL_NODE);
+}
+
+void writer::write_statement(const statement *const s)
+{
+    if (s)
+        s->write(*this);
+    else
+        write_kind(NULL_NODE);
+}
+
+reader::reader(std::istream &is) : is(is)
+{
+    // the bytes left into the stream bound the sizes read from it..
+    const std::streampos c_pos = is.tellg();
+    is.seekg(0, std::ios::end);
+    left = static_cast<size_t>(is.tellg() - c_pos);
+    is.seekg(c_pos);
+}
+reader::~reader() {}
+
+// owns the nodes read so far, until they are handed to their parent, so that they are deleted if a later part of the input turns out to be malformed..
+template <typename T>
+class pending_nodes
+{
+public:
+    pending_nodes() {}
+    pending_nodes(const pending_nodes &orig) = delete;
+    ~pending_nodes()
+    {
+        for (const auto &n : nodes)
+            delete n;
+    }
+
+    T *add(T *const n)
+    {
+        if (n) // optional nodes might be missing..
+            nodes.push_back(n);
+        return n;
+    }
+    void release() { nodes.clear(); } // the nodes have been handed to their parent..
+
+private:
+    std::vector<T *> nodes;
+};
+
+compilation_unit *reader::read_compilation_unit()
+{
+    pending_nodes<method_declaration> p_ms;
+    std::vector<method_declaration *> ms(read_count());
+    for (auto &m : ms)
+        m = p_ms.add(read_method_declaration());
+    pending_nodes<predicate_declaration> p_ps;
+    std::vector<predicate_declaration *> ps(read_count());
+    for (auto &p : ps)
+        p = p_ps.add(read_predicate_declaration());
+    pending_nodes<type_declaration> p_ts;
+    std::vector<type_declaration *> ts(read_count());
+    for (auto &t : ts)
+        t = p_ts.add(read_type_declaration());
+    pending_nodes<statement> p_ss;
+    std::vector<statement *> ss(read_count());
+    for (auto &s : ss)
+        s = p_ss.add(read_statement());
+    compilation_unit *cu = new compilation_unit(ms, ps, ts, ss);
+    p_ms.release();
+    p_ps.release();
+    p_ts.release();
+    p_ss.release();
+    return cu;
+}
+
+node_kind reader::read_kind()
+{
+    const int k = get();
+    if (k < NULL_NODE || k > NOT_EXPRESSION)
+        error("invalid node kind..");
+    return static_cast<node_kind>(k);
+}
+
+bool reader::read_bool()
+{
+    const int b = get();
+    if (b != 0 && b != 1)
+        error("invalid boolean..");
+    return b == 1;
+}
+
+size_t reader::read_size()
+{
+    size_t n = 0;
+    for (unsigned shift = 0; shift < sizeof(size_t) * 8; shift += 7)
+    {
+        const int c = get();
+        if (c == EOF)
+            error("unexpected end of file..");
+        n |= static_cast<size_t>(c & 0x7F) << shift;
+        if (!(c & 0x80))
+            return n;
+    }
+    error("invalid size..");
+    return 0;
+}
+
+size_t reader::read_count()
+{
+    const size_t n = read_size();
+    if (n > left) // every element takes at least one byte, hence, a corrupted count is detected before allocating its elements..
+        error("invalid size..");
+    return n;
+}
+
+int reader::get()
+{
+    const int c = is.get();
+    if (c != EOF)
+        left--;
+    return c;
+}
+
+smt::I reader::read_int()
+{
+    const size_t n = read_size();
+    return static_cast<smt::I>((n >> 1) ^ (~(n & 1) + 1));
+}
+
+smt::rational reader::read_rational()
+{
+    const smt::I num = read_int();
+    const smt::I den = read_int();
+    if (den == 0) // infinite literals cannot be written..
+        error("invalid rational..");
+    return smt::rational(num, den);
+}
+
+std::string reader::read_string()
+{
+    const size_t idx = read_size();
+    if (idx < strings.size())
+        return strings[idx];
+    if (idx > strings.size())
+        error("invalid string index..");
+    // a new string..
+    std::string str(read_count(), '\0');
+    if (!is.read(&str[0], str.size()))
+        error("unexpected end of file..");
+    left -= str.size();
+    strings.push_back(str);
+    return str;
+}
+
+std::vector<std::string> reader::read_ids()
+{
+    std::vector<std::string> ids(read_count());
+    for (auto &id : ids)
+        id = read_string();
+    return ids;
+}
+
+std::vector<std::pair<std::vector<std::string>, std::string>> reader::read_parameters()
+{
+    std::vector<std::pair<std::vector<std::string>, std::string>> pars;
+    const size_t n_pars = read_count();
+    for (size_t i = 0; i < n_pars; ++i)
+    {
+        std::vector<std::string> tp = read_ids();
+        pars.push_back({tp, read_string()});
+    }
+    return pars;
+}
+
+type_declaration *reader::read_type_declaration()
+{
+    switch (read_kind())
+    {
+    case TYPEDEF_DECLARATION:
+    {
+        std::string n = read_string();
+        std::string pt = read_string();
+        return new typedef_declaration(n, pt, read_expression());
+    }
+    case ENUM_DECLARATION:
+    {
+        std::string n = read_string();
+        std::vector<std::string> es = read_ids();
+        std::vector<std::vector<std::string>> trs(read_count());
+        for (auto &tr : trs)
+            tr = read_ids();
+        return new enum_declaration(n, es, trs);
+    }
+    case CLASS_DECLARATION:
+    {
+        std::string n = read_string();
+        std::vector<std::vector<std::string>> bcs(read_count());
+        for (auto &bc : bcs)
+            bc = read_ids();
+        pending_nodes<field_declaration> p_fs;
+        std::vector<field_declaration *> fs(read_count());
+        for (auto &f : fs)
+            f = p_fs.add(read_field_declaration());
+        pending_nodes<constructor_declaration> p_cs;
+        std::vector<constructor_declaration *> cs(read_count());
+        for (auto &c : cs)
+            c = p_cs.add(read_constructor_declaration());
+        pending_nodes<method_declaration> p_ms;
+        std::vector<method_declaration *> ms(read_count());
+        for (auto &m : ms)
+            m = p_ms.add(read_method_declaration());
+        pending_nodes<predicate_declaration> p_ps;
+        std::vector<predicate_declaration *> ps(read_count());
+        for (auto &p : ps)
+            p = p_ps.add(read_predicate_declaration());
+        pending_nodes<type_declaration> p_ts;
+        std::vector<type_declaration *> ts(read_count());
+        for (auto &t : ts)
+            t = p_ts.add(read_type_declaration());
+        class_declaration *cd = new class_declaration(n, bcs, fs, cs, ms, ps, ts);
+        p_fs.release();
+        p_cs.release();
+        p_ms.release();
+        p_ps.release();
+        p_ts.release();
+        return cd;
+    }
+    default:
+        error("expected a type declaration..");
+        return nullptr;
+    }
+}
+
+field_declaration *reader::read_field_declaration()
+{
+    std::vector<std::string> tp = read_ids();
+    pending_nodes<variable_declaration> p_ds;
+    std::vector<variable_declaration *> ds(read_count());
+    for (auto &d : ds)
+    {
+        std::string n = read_string();
+        d = p_ds.add(new variable_declaration(n, read_expression()));
+    }
+    field_declaration *fd = new field_declaration(tp, ds);
+    p_ds.release();
+    return fd;
+}
+
+constructor_declaration *reader::read_constructor_declaration()
+{
+    std::vector<std::pair<std::vector<std::string>, std::string>> pars = read_parameters();
+    pending_nodes<expression> p_es;
+    std::vector<std::pair<std::string, std::vector<expression *>>> il;
+    const size_t n_il = read_count();
+    for (size_t i = 0; i < n_il; ++i)
+    {
+        std::string n = read_string();
+        std::vector<expression *> es = read_expressions();
+        for (const auto &e : es)
+            p_es.add(e);
+        il.push_back({n, es});
+    }
+    pending_nodes<statement> p_ss;
+    std::vector<statement *> stmnts(read_count());
+    for (auto &s : stmnts)
+        s = p_ss.add(read_statement());
+    constructor_declaration *cd = new constructor_declaration(pars, il, stmnts);
+    p_es.release();
+    p_ss.release();
+    return cd;
+}
+
+method_declaration *reader::read_method_declaration()
+{
+    std::vector<std::string> rt = read_ids();
+    std::string n = read_string();
+    std::vector<std::pair<std::vector<std::string>, std::string>> pars = read_parameters();
+    pending_nodes<statement> p_ss;
+    std::vector<statement *> stmnts(read_count());
+    for (auto &s : stmnts)
+        s = p_ss.add(read_statement());
+    method_declaration *md = new method_declaration(rt, n, pars, stmnts);
+    p_ss.release();
+    return md;
+}
+
+predicate_declaration *reader::read_predicate_declaration()
+{
+    std::string n = read_string();
+    std::vector<std::pair<std::vector<std::string>, std::string>> pars = read_parameters();
+    std::vector<std::vector<std::string>> pl(read_count());
+    for (auto &p : pl)
+        p = read_ids();
+    pending_nodes<statement> p_ss;
+    std::vector<statement *> stmnts(read_count());
+    for (auto &s : stmnts)
+        s = p_ss.add(read_statement());
+    predicate_declaration *pd = new predicate_declaration(n, pars, pl, stmnts);
+    p_ss.release();
+    return pd;
+}
+
+statement *reader::read_statement()
+{
+    switch (read_kind())
+    {
+    case NULL_NODE:
+        return nullptr;
+    case ASSIGNMENT_STATEMENT:
+    {
+        std::vector<std::string> is = read_ids();
+        std::string i = read_string();
+        return new assignment_statement(is, i, read_expression());
+    }
+    case LOCAL_FIELD_STATEMENT:
+    {
+        std::vector<std::string> ft = read_ids();
+        std::string n = read_string();
+        return new local_field_statement(ft, n, read_expression());
+    }
+    case EXPRESSION_STATEMENT:
+        return new expression_statement(read_expression());
+    case BLOCK_STATEMENT:
+    {
+        pending_nodes<const statement> p_ss;
+        std::vector<const statement *> stmnts(read_count());
+        for (auto &s : stmnts)
+            s = p_ss.add(read_statement());
+        block_statement *bs = new block_statement(stmnts);
+        p_ss.release();
+        return bs;
+    }
+    case DISJUNCTION_STATEMENT:
+    {
+        pending_nodes<const statement> p_ss;
+        pending_nodes<const expression> p_es;
+        std::vector<std::pair<std::vector<const statement *>, const expression *const>> conjs;
+        const size_t n_conjs = read_count();
+        for (size_t i = 0; i < n_conjs; ++i)
+        {
+            std::vector<const statement *> stmnts(read_count());
+            for (auto &s : stmnts)
+                s = p_ss.add(read_statement());
+            conjs.push_back({stmnts, p_es.add(read_expression())});
+        }
+        disjunction_statement *ds = new disjunction_statement(conjs);
+        p_ss.release();
+        p_es.release();
+        return ds;
+    }
+    case FORMULA_STATEMENT:
+    {
+        bool isf = read_bool();
+        std::string fn = read_string();
+        std::vector<std::string> scp = read_ids();
+        std::string pn = read_string();
+        pending_nodes<const expression> p_es;
+        std::vector<std::pair<std::string, const expression *>> assns;
+        const size_t n_assns = read_count();
+        for (size_t i = 0; i < n_assns; ++i)
+        {
+            std::string n = read_string();
+            assns.push_back({n, p_es.add(read_expression())});
+        }
+        formula_statement *fs = new formula_statement(isf, fn, scp, pn, assns);
+        p_es.release();
+        return fs;
+    }
+    case RETURN_STATEMENT:
+        return new return_statement(read_expression());
+    default:
+        error("expected a statement..");
+        return nullptr;
+    }
+}
+
+expression *reader::read_expression()
+{
+    const node_kind k = read_kind();
+    switch (k)
+    {
+    case NULL_NODE:
+        return nullptr;
+    case CAST_EXPRESSION:
+    {
+        std::vector<std::string> tp = read_ids();
+        return new cast_expression(tp, read_expression());
+    }
+    case CONSTRUCTOR_EXPRESSION:
+    {
+        std::vector<std::string> it = read_ids();
+        return new constructor_expression(it, read_expressions());
+    }
+    case ID_EXPRESSION:
+        return new id_expression(read_ids());
+    case FUNCTION_EXPRESSION:
+    {
+        std::vector<std::string> is = read_ids();
+        std::string fn = read_string();
+        return new function_expression(is, fn, read_expressions());
+    }
+    case STRING_LITERAL_EXPRESSION:
+        return new string_literal_expression(read_string());
+    case INT_LITERAL_EXPRESSION:
+        return new int_literal_expression(read_int());
+    case REAL_LITERAL_EXPRESSION:
+        return new real_literal_expression(read_rational());
+    case PLUS_EXPRESSION:
+        return new plus_expression(read_expression());
+    case MINUS_EXPRESSION:
+        return new minus_expression(read_expression());
+    case RANGE_EXPRESSION:
+    {
+        pending_nodes<expression> p_es;
+        expression *min_e = p_es.add(read_expression());
+        range_expression *re = new range_expression(min_e, read_expression());
+        p_es.release();
+        return re;
+    }
+    case ADDITION_EXPRESSION:
+        return new addition_expression(read_expressions());
+    case SUBTRACTION_EXPRESSION:
+        return new subtraction_expression(read_expressions());
+    case MULTIPLICATION_EXPRESSION:
+        return new multiplication_expression(read_expressions());
+    case DIVISION_EXPRESSION:
+        return new division_expression(read_expressions());
+    case BOOL_LITERAL_EXPRESSION:
+        return new bool_literal_expression(read_bool());
+    case EQ_EXPRESSION:
+    case NEQ_EXPRESSION:
+    case LT_EXPRESSION:
+    case LEQ_EXPRESSION:
+    case GEQ_EXPRESSION:
+    case GT_EXPRESSION:
+    case IMPLICATION_EXPRESSION:
+    {
+        pending_nodes<expression> p_es;
+        expression *l = p_es.add(read_expression());
+        expression *r = read_expression();
+        p_es.release();
+        switch (k)
+        {
+        case EQ_EXPRESSION:
+            return new eq_expression(l, r);
+        case NEQ_EXPRESSION:
+            return new neq_expression(l, r);
+        case LT_EXPRESSION:
+            return new lt_expression(l, r);
+        case LEQ_EXPRESSION:
+            return new leq_expression(l, r);
+        case GEQ_EXPRESSION:
+            return new geq_expression(l, r);
+        case GT_EXPRESSION:
+            return new gt_expression(l, r);
+        default:
+            return new implication_expression(l, r);
+        }
+    }
+    case DISJUNCTION_EXPRESSION:
+        return new disjunction_expression(read_expressions());
+    case CONJUNCTION_EXPRESSION:
+        return new conjunction_expression(read_expressions());
+    case EXCT_ONE_EXPRESSION:
+        return new exct_one_expression(read_expressions());
+    case NOT_EXPRESSION:
+        return new not_expression(read_expression());
+    default:
+        error("expected an expression..");
+        return nullptr;
+    }
+}
+
+std::vector<expression *> reader::read_expressions()
+{
+    pending_nodes<expression> p_es;
+    std::vector<expression *> es(read_count());
+    for (auto &e : es)
+        e = p_es.add(read_expression());
+    p_es.release();
+    return es;
+}
+
+void reader::error(const std::string &err) { throw std::invalid_argument("[" + std::to_string(is.tellg()) + "] " + err); }
+
+uint64_t content_hash(const std::string &str)
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (const auto &c : str)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// returns a suffix which is unique to the calling thread of this process, so that concurrent writers never share their temporary files..
+static std::string writer_id() { return std::to_string(getpid()) + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())); }
+
+std::string cache_file(const std::string &dir, const uint64_t &src_hash)
+{
+    std::ostringstream name;
+    name << dir << '/' << std::hex << std::setw(16) << std::setfill('0') << src_hash << ".rddlc";
+    return name.str();
+}
+
+bool cache_writable(const std::string &dir)
+{
+    const std::string probe = dir + "/." + writer_id() + ".probe";
+    std::ofstream ofs(probe, std::ios::binary);
+    if (!ofs || !ofs.put('\0'))
+        return false;
+    ofs.close();
+    std::remove(probe.c_str());
+    return true;
+}
+
+void store_cache(const std::string &file, const uint64_t &src_hash, const compilation_unit &cu)
+{
+    // we first write a temporary file, which is then renamed, so that concurrent readers never see a partially written cache..
+    const std::string tmp_file = file + "." + writer_id() + ".tmp";
+    std::ofstream ofs(tmp_file, std::ios::binary);
+    if (!ofs)
+        return;
+    ofs.write(CACHE_MAGIC, sizeof(CACHE_MAGIC) - 1);
+    writer w(ofs);
+    w.write_size(CACHE_VERSION);
+    w.write_size(src_hash);
+    cu.write(w);
+    ofs.close();
+    if (!ofs || std::rename(tmp_file.c_str(), file.c_str()) != 0)
+        std::remove(tmp_file.c_str());
+}
+
+compilation_unit *load_cache(const std::string &file, const uint64_t &src_hash)
+{
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs)
+        return nullptr;
+    char magic[sizeof(CACHE_MAGIC) - 1];
+    if (!ifs.read(magic, sizeof(magic)) || std::string(magic, sizeof(magic)) != CACHE_MAGIC)
+        return nullptr;
+    try
+    {
+        reader r(ifs);
+        if (r.read_size() != CACHE_VERSION || r.read_size() != src_hash)
+            return nullptr;
+        compilation_unit *cu = r.read_compilation_unit();
+        if (ifs.peek() != EOF)
+        {
+            delete cu;
+            return nullptr;
+        }
+        return cu;
+    }
+    catch (const std::exception &)
+    { // a corrupted cache is simply ignored (and will be overwritten)..
+        return nullptr;
+    }
+}
+}
+}
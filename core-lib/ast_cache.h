@@ -0,0 +1,146 @@
+#pragma once
+
+#include "rational.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+namespace lucy
+{
+
+namespace ast
+{
+
+class compilation_unit;
+class type_declaration;
+class field_declaration;
+class constructor_declaration;
+class method_declaration;
+class predicate_declaration;
+class statement;
+class expression;
+
+enum node_kind
+{
+  NULL_NODE,                 // a missing optional node
+  TYPEDEF_DECLARATION,       // 'typedef_declaration'
+  ENUM_DECLARATION,          // 'enum_declaration'
+  CLASS_DECLARATION,         // 'class_declaration'
+  ASSIGNMENT_STATEMENT,      // 'assignment_statement'
+  LOCAL_FIELD_STATEMENT,     // 'local_field_statement'
+  EXPRESSION_STATEMENT,      // 'expression_statement'
+  BLOCK_STATEMENT,           // 'block_statement'
+  DISJUNCTION_STATEMENT,     // 'disjunction_statement'
+  FORMULA_STATEMENT,         // 'formula_statement'
+  RETURN_STATEMENT,          // 'return_statement'
+  CAST_EXPRESSION,           // 'cast_expression'
+  CONSTRUCTOR_EXPRESSION,    // 'constructor_expression'
+  ID_EXPRESSION,             // 'id_expression'
+  FUNCTION_EXPRESSION,       // 'function_expression'
+  STRING_LITERAL_EXPRESSION, // 'string_literal_expression'
+  INT_LITERAL_EXPRESSION,    // 'int_literal_expression'
+  REAL_LITERAL_EXPRESSION,   // 'real_literal_expression'
+  PLUS_EXPRESSION,           // 'plus_expression'
+  MINUS_EXPRESSION,          // 'minus_expression'
+  RANGE_EXPRESSION,          // 'range_expression'
+  ADDITION_EXPRESSION,       // 'addition_expression'
+  SUBTRACTION_EXPRESSION,    // 'subtraction_expression'
+  MULTIPLICATION_EXPRESSION, // 'multiplication_expression'
+  DIVISION_EXPRESSION,       // 'division_expression'
+  BOOL_LITERAL_EXPRESSION,   // 'bool_literal_expression'
+  EQ_EXPRESSION,             // 'eq_expression'
+  NEQ_EXPRESSION,            // 'neq_expression'
+  LT_EXPRESSION,             // 'lt_expression'
+  LEQ_EXPRESSION,            // 'leq_expression'
+  GEQ_EXPRESSION,            // 'geq_expression'
+  GT_EXPRESSION,             // 'gt_expression'
+  IMPLICATION_EXPRESSION,    // 'implication_expression'
+  DISJUNCTION_EXPRESSION,    // 'disjunction_expression'
+  CONJUNCTION_EXPRESSION,    // 'conjunction_expression'
+  EXCT_ONE_EXPRESSION,       // 'exct_one_expression'
+  NOT_EXPRESSION             // 'not_expression'
+};
+
+// writes abstract syntax trees in a compact binary form (sizes and integers are variable-length encoded, while strings are written once and then referred by their index)..
+class writer
+{
+public:
+  writer(std::ostream &os);
+  writer(const writer &orig) = delete;
+  virtual ~writer();
+
+  void write_kind(const node_kind &k) { os.put(static_cast<char>(k)); }
+  void write_bool(const bool &b) { os.put(b ? 1 : 0); }
+  void write_size(size_t n);
+  void write_int(const smt::I &i) { write_size((static_cast<size_t>(i) << 1) ^ static_cast<size_t>(i >> (sizeof(smt::I) * 8 - 1))); } // zig-zag encoding, so that small negative numbers stay small..
+  void write_rational(const smt::rational &r);
+  void write_string(const std::string &str);
+  void write_ids(const std::vector<std::string> &ids);
+  void write_parameters(const std::vector<std::pair<std::vector<std::string>, std::string>> &pars);
+  void write_expression(const expression *const e); // writes the given (possibly null) expression..
+  void write_statement(const statement *const s);   // writes the given (possibly null) statement..
+
+  template <typename T>
+  void write_all(const std::vector<T> &nodes)
+  {
+    write_size(nodes.size());
+    for (const auto &n : nodes)
+      n->write(*this);
+  }
+
+private:
+  std::ostream &os;
+  std::unordered_map<std::string, size_t> strings; // the strings written so far, along with their index..
+};
+
+// reads abstract syntax trees written by a 'writer', throws an 'std::invalid_argument' if the input is malformed..
+class reader
+{
+public:
+  reader(std::istream &is);
+  reader(const reader &orig) = delete;
+  virtual ~reader();
+
+  compilation_unit *read_compilation_unit();
+  size_t read_size();
+
+private:
+  size_t read_count(); // reads a number of elements (or of bytes), rejecting those which cannot fit into the rest of the stream..
+  int get();           // reads a byte, keeping track of the bytes left..
+  node_kind read_kind();
+  bool read_bool();
+  smt::I read_int();
+  smt::rational read_rational();
+  std::string read_string();
+  std::vector<std::string> read_ids();
+  std::vector<std::pair<std::vector<std::string>, std::string>> read_parameters();
+
+  type_declaration *read_type_declaration();
+  field_declaration *read_field_declaration();
+  constructor_declaration *read_constructor_declaration();
+  method_declaration *read_method_declaration();
+  predicate_declaration *read_predicate_declaration();
+  statement *read_statement();
+  expression *read_expression();
+  std::vector<expression *> read_expressions();
+
+  void error(const std::string &err);
+
+private:
+  std::istream &is;
+  size_t left;                      // the number of bytes which have not been read yet..
+  std::vector<std::string> strings; // the strings read so far..
+};
+
+uint64_t content_hash(const std::string &str); // computes the (FNV-1a) hash of the given string..
+
+std::string cache_file(const std::string &dir, const uint64_t &src_hash);                         // returns the name of the cache file, within the given folder, of a source having the given hash (sources having the same content share their cache)..
+bool cache_writable(const std::string &dir);                                                     // checks whether cache files can be written into the given folder..
+void store_cache(const std::string &file, const uint64_t &src_hash, const compilation_unit &cu); // stores the given compilation unit into the given cache file, along with the hash of its source (failures are ignored, since caches are just an optimization and their folder has been checked by 'cache_writable')..
+compilation_unit *load_cache(const std::string &file, const uint64_t &src_hash);                 // loads a compilation unit from the given cache file, returns a nullptr if the cache is missing, stale or corrupted..
+}
+}
+
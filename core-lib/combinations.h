@@ -7,25 +7,47 @@
 namespace lucy
 {
 
+// calls 'f' on each pair of elements of the given vector, in lexicographic order, without allocating any memory..
+template <typename T, typename F>
+void for_each_pair(const std::vector<T> &v, F f)
+{
+    for (size_t i = 0; i < v.size(); ++i)
+        for (size_t j = i + 1; j < v.size(); ++j)
+            f(v[i], v[j]);
+}
+
+// calls 'f' on each n-combination of elements of the given vector, in lexicographic order, reusing the same buffer for all the combinations..
+template <typename T, typename F>
+void for_each_combination(const std::vector<T> &v, const size_t &n, F f)
+{
+    assert(v.size() >= n);
+    std::vector<size_t> idxs(n); // the indexes of the elements of the current combination..
+    for (size_t i = 0; i < n; ++i)
+        idxs[i] = i;
+    std::vector<T> c_comb(n);
+    while (true)
+    {
+        for (size_t i = 0; i < n; ++i)
+            c_comb[i] = v[idxs[i]];
+        f(static_cast<const std::vector<T> &>(c_comb));
+
+        // we look for the rightmost index which can still be increased..
+        size_t i = n;
+        while (i > 0 && idxs[i - 1] == v.size() - n + i - 1)
+            --i;
+        if (i == 0) // this was the last combination..
+            return;
+        ++idxs[i - 1];
+        for (size_t j = i; j < n; ++j)
+            idxs[j] = idxs[j - 1] + 1;
+    }
+}
+
 template <typename T>
 std::vector<std::vector<T>> combinations(const std::vector<T> &v, const size_t &n)
 {
-    assert(v.size() >= n);
     std::vector<std::vector<T>> combs;
-    std::string bitmask(n, 1);   // K leading 1's
-    bitmask.resize(v.size(), 0); // N-K trailing 0's
-
-    // print integers and permute bitmask
-    do
-    {
-        std::vector<T> c_comb;
-        c_comb.reserve(n);
-        // [0..N-1] integers
-        for (size_t i = 0; i < v.size(); ++i)
-            if (bitmask.at(i))
-                c_comb.push_back(v[i]);
-        combs.push_back(c_comb);
-    } while (std::prev_permutation(bitmask.begin(), bitmask.end()));
+    for_each_combination(v, n, [&](const std::vector<T> &c_comb) { combs.push_back(c_comb); });
     return combs;
 }
-}
\ No newline at end of file
+}
@@ -4,6 +4,9 @@
 #include "method.h"
 #include "field.h"
 #include "declaration.h"
+#include "domain.h"
+#include "fact_loader.h"
+#include "solution_writer.h"
 #include <algorithm>
 #include <iostream>
 #include <sstream>
@@ -58,20 +61,17 @@ void core::read(const std::string &script)
 
 void core::read(const std::vector<std::string> &files)
 {
-    std::vector<ast::compilation_unit *> c_cus;
+    std::vector<std::string> rddl_files;
+    std::vector<std::string> facts_files;
     for (const auto &f : files)
-    {
-        std::ifstream ifs(f);
-        if (ifs)
-        {
-            ast::compilation_unit *cu = prs.parse(ifs);
-            c_cus.push_back(cu);
-            cus.push_back(cu);
-            ifs.close();
-        }
+        if (f.size() > 6 && f.compare(f.size() - 6, 6, ".facts") == 0)
+            facts_files.push_back(f);
         else
-            throw std::invalid_argument("file not found: " + f);
-    }
+            rddl_files.push_back(f);
+
+    // the files are parsed concurrently, while their compilation units are declared, refined and executed in the given order..
+    std::vector<ast::compilation_unit *> c_cus = parser::parse_all(rddl_files);
+    cus.insert(cus.end(), c_cus.begin(), c_cus.end());
 
     for (const auto &cu : c_cus)
         cu->declare(*this);
@@ -81,6 +81,30 @@ void core::read(const std::vector<std::string> &files)
     for (const auto &cu : c_cus)
         cu->execute(*this, c_ctx);
 
+    // the facts files bypass the parser..
+    fact_loader ldr(*this);
+    for (const auto &f : facts_files)
+    {
+        std::ifstream ifs(f);
+        if (!ifs)
+            throw std::invalid_argument("file not found: " + f);
+        ldr.load(ifs);
+    }
+
+    if (!sat_cr.check())
+        throw unsolvable_exception("the input problem is inconsistent");
+}
+
+void core::read(const domain &dom)
+{
+    for (const auto &cu : dom.get_compilation_units())
+        cu->declare(*this);
+    for (const auto &cu : dom.get_compilation_units())
+        cu->refine(*this);
+    context c_ctx(this);
+    for (const auto &cu : dom.get_compilation_units())
+        cu->execute(*this, c_ctx);
+
     if (!sat_cr.check())
         throw unsolvable_exception("the input problem is inconsistent");
 }
@@ -123,7 +147,7 @@ expr core::new_enum(const type &tp, const std::vector<var> &vars, const std::vec
         bool nc;
         for (size_t i = 0; i < vars.size(); ++i)
         {
-            nc = sat_cr.new_clause({lit(vars.at(i), false), sat_cr.new_eq(dynamic_cast<bool_item *>(vals.at(i))->l, b->l)});
+            nc = sat_cr.new_clause({lit(vars.at(i), false), sat_cr.new_eq(static_cast<bool_item *>(vals.at(i))->l, b->l)});
             assert(nc);
         }
         return b;
@@ -134,7 +158,7 @@ expr core::new_enum(const type &tp, const std::vector<var> &vars, const std::vec
         bool nc;
         for (size_t i = 0; i < vars.size(); ++i)
         {
-            nc = sat_cr.new_clause({lit(vars.at(i), false), sat_cr.new_conj({la_th.new_leq(ie->l, dynamic_cast<arith_item *>(vals.at(i))->l), la_th.new_geq(ie->l, dynamic_cast<arith_item *>(vals.at(i))->l)})});
+            nc = sat_cr.new_clause({lit(vars.at(i), false), sat_cr.new_conj({la_th.new_leq(ie->l, static_cast<arith_item *>(vals.at(i))->l), la_th.new_geq(ie->l, static_cast<arith_item *>(vals.at(i))->l)})});
             assert(nc);
         }
         return ie;
@@ -145,7 +169,7 @@ expr core::new_enum(const type &tp, const std::vector<var> &vars, const std::vec
         bool nc;
         for (size_t i = 0; i < vars.size(); ++i)
         {
-            nc = sat_cr.new_clause({lit(vars.at(i), false), sat_cr.new_conj({la_th.new_leq(re->l, dynamic_cast<arith_item *>(vals.at(i))->l), la_th.new_geq(re->l, dynamic_cast<arith_item *>(vals.at(i))->l)})});
+            nc = sat_cr.new_clause({lit(vars.at(i), false), sat_cr.new_conj({la_th.new_leq(re->l, static_cast<arith_item *>(vals.at(i))->l), la_th.new_geq(re->l, static_cast<arith_item *>(vals.at(i))->l)})});
             assert(nc);
         }
         return re;
@@ -318,161 +342,22 @@ inf_rational core::arith_ub(const arith_expr &x) const noexcept { return la_th.u
 inf_rational core::arith_value(const arith_expr &x) const noexcept { return la_th.value(x->l); }
 std::unordered_set<var_value *> core::enum_value(const var_expr &x) const noexcept { return ov_th.value(x->ev); }
 
-std::string core::to_string(const std::map<std::string, expr> &c_items) const noexcept
-{
-    std::string iss;
-    for (std::map<std::string, expr>::const_iterator is_it = c_items.begin(); is_it != c_items.end(); ++is_it)
-    {
-        if (is_it != c_items.begin())
-            iss += ", ";
-        iss += "{ \"name\" : \"" + is_it->first + "\", \"type\" : \"" + is_it->second->tp.name + "\", \"value\" : ";
-        if (bool_item *bi = dynamic_cast<bool_item *>(&*is_it->second))
-        {
-            std::string sign_s = bi->l.sign ? "b" : "!b";
-            iss += "{ \"lit\" : \"" + sign_s + std::to_string(bi->l.v) + "\", \"val\" : ";
-            switch (sat_cr.value(bi->l))
-            {
-            case True:
-                iss += "\"True\"";
-                break;
-            case False:
-                iss += "\"False\"";
-                break;
-            case Undefined:
-                iss += "\"Undefined\"";
-                break;
-            }
-            iss += " }";
-        }
-        else if (arith_item *ai = dynamic_cast<arith_item *>(&*is_it->second))
-        {
-            const auto val = la_th.value(ai->l);
-            iss += "{ \"lin\" : \"" + ai->l.to_string() + "\", \"val\" : ";
-            iss += "{ \"num\" : " + std::to_string(val.get_rational().numerator()) + ", \"den\" : " + std::to_string(val.get_rational().denominator());
-            if (val.get_infinitesimal() != rational::ZERO)
-                iss += ", \"inf\" : { \"num\" : " + std::to_string(val.get_infinitesimal().numerator()) + ", \"den\" : " + std::to_string(val.get_infinitesimal().denominator()) + " }";
-            iss += " }";
-            const auto lb = la_th.lb(ai->l);
-            if (!lb.is_negative_infinite())
-            {
-                iss += ", \"lb\" : { \"num\" : " + std::to_string(lb.get_rational().numerator()) + ", \"den\" : " + std::to_string(lb.get_rational().denominator());
-                if (val.get_infinitesimal() != rational::ZERO)
-                    iss += ", \"inf\" : { \"num\" : " + std::to_string(lb.get_infinitesimal().numerator()) + ", \"den\" : " + std::to_string(lb.get_infinitesimal().denominator()) + " }";
-                iss += " }";
-            }
-            const auto ub = la_th.ub(ai->l);
-            if (!ub.is_positive_infinite())
-            {
-                iss += ", \"ub\" : { \"num\" : " + std::to_string(ub.get_rational().numerator()) + ", \"den\" : " + std::to_string(ub.get_rational().denominator());
-                if (val.get_infinitesimal() != rational::ZERO)
-                    iss += ", \"inf\" : { \"num\" : " + std::to_string(ub.get_infinitesimal().numerator()) + ", \"den\" : " + std::to_string(ub.get_infinitesimal().denominator()) + " }";
-                iss += " }";
-            }
-            iss += " }";
-        }
-        else if (var_item *ei = dynamic_cast<var_item *>(&*is_it->second))
-        {
-            iss += "{ \"var\" : \"e" + std::to_string(ei->ev) + "\", \"vals\" : [ ";
-            std::unordered_set<var_value *> vals = ov_th.value(ei->ev);
-            for (std::unordered_set<var_value *>::iterator vals_it = vals.begin(); vals_it != vals.end(); ++vals_it)
-            {
-                if (vals_it != vals.begin())
-                    iss += ", ";
-                iss += "\"" + std::to_string(reinterpret_cast<uintptr_t>(static_cast<item *>(*vals_it))) + "\"";
-            }
-            iss += " ] }";
-        }
-        else
-            iss += "\"" + std::to_string(reinterpret_cast<uintptr_t>(&*is_it->second)) + "\"";
-        iss += " }";
-    }
-    return iss;
-}
-
-std::string core::to_string(const item *const i) const noexcept
+void core::write(std::ostream &os) const
 {
-    std::string is;
-    is += "{ \"id\" : \"" + std::to_string(reinterpret_cast<uintptr_t>(i)) + "\", \"type\" : \"" + i->tp.name + "\"";
-    std::map<std::string, expr> c_is = i->get_items();
-    if (!c_is.empty())
-        is += ", \"items\" : [ " + to_string(c_is) + " ]";
-    is += "}";
-    return is;
+    solution_writer w(*this, os);
+    w.write();
 }
 
-std::string core::to_string(const atom *const a) const noexcept
+void core::write_binary(std::ostream &os) const
 {
-    std::string as;
-    as += "{ \"id\" : \"" + std::to_string(reinterpret_cast<uintptr_t>(a)) + "\", \"predicate\" : \"" + a->tp.name + "\", \"state\" : ";
-    switch (sat_cr.value(a->sigma))
-    {
-    case True:
-        as += "\"Active\"";
-        break;
-    case False:
-        as += "\"Unified\"";
-        break;
-    case Undefined:
-        as += "\"Inactive\"";
-        break;
-    }
-    std::map<std::string, expr> is = a->get_items();
-    if (!is.empty())
-        as += ", \"pars\" : [ " + to_string(is) + " ]";
-    as += "}";
-    return as;
+    solution_writer w(*this, os);
+    w.write_binary();
 }
 
 std::string core::to_string() const noexcept
 {
-    std::set<item *> all_items;
-    std::set<atom *> all_atoms;
-    for (const auto &p : get_predicates())
-        for (const auto &a : p.second->get_instances())
-            all_atoms.insert(static_cast<atom *>(&*a));
-    std::queue<type *> q;
-    for (const auto &t : get_types())
-        if (!t.second->primitive)
-            q.push(t.second);
-    while (!q.empty())
-    {
-        for (const auto &i : q.front()->get_instances())
-            all_items.insert(&*i);
-        for (const auto &p : q.front()->get_predicates())
-            for (const auto &a : p.second->get_instances())
-                all_atoms.insert(static_cast<atom *>(&*a));
-        q.pop();
-    }
-
-    std::string cr;
-    cr += "{ ";
-    if (!all_items.empty())
-    {
-        cr += "\"items\" : [";
-        for (std::set<item *>::iterator is_it = all_items.begin(); is_it != all_items.end(); ++is_it)
-        {
-            if (is_it != all_items.begin())
-                cr += ", ";
-            cr += to_string(*is_it);
-        }
-        cr += "]";
-    }
-    if (!all_atoms.empty())
-    {
-        if (!all_items.empty())
-            cr += ", ";
-        cr += "\"atoms\" : [";
-        for (std::set<atom *>::iterator as_it = all_atoms.begin(); as_it != all_atoms.end(); ++as_it)
-        {
-            if (as_it != all_atoms.begin())
-                cr += ", ";
-            cr += to_string(*as_it);
-        }
-        cr += "]";
-    }
-    if (!all_items.empty() || !all_atoms.empty())
-        cr += ", ";
-    cr += "\"refs\" : [" + to_string(get_items()) + "] }";
-    return cr;
+    std::stringstream ss;
+    write(ss);
+    return ss.str();
+}
 }
-}
\ No newline at end of file
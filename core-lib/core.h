@@ -26,6 +26,8 @@ class var_item;
 class disjunction;
 class atom_state;
 class parser;
+class domain;
+class fact_loader;
 
 namespace ast
 {
@@ -59,6 +61,7 @@ public:
 class core : public scope, public env
 {
   friend class type;
+  friend class item;
   friend class var_item;
   friend class ast::typedef_declaration;
   friend class ast::enum_declaration;
@@ -68,14 +71,16 @@ class core : public scope, public env
   friend class ast::local_field_statement;
   friend class ast::disjunction_statement;
   friend class ast::formula_statement;
+  friend class fact_loader;
 
 public:
   core();
   core(const core &orig) = delete;
   ~core();
 
-  void read(const std::string &script);
-  void read(const std::vector<std::string> &files);
+  virtual void read(const std::string &script);
+  virtual void read(const std::vector<std::string> &files); // files with a '.facts' extension are loaded, in bulk, by a 'fact_loader' after the other files have been executed..
+  virtual void read(const domain &dom); // reads the (already parsed) given domain, which is not owned by this core and must outlive it..
 
   bool_expr new_bool();
   bool_expr new_bool(const bool &val);
@@ -155,12 +160,9 @@ protected:
   void restore_var() { ctr_var = tmp_var; }
 
 public:
-  std::string to_string() const noexcept;
-
-private:
-  std::string to_string(const item *const i) const noexcept;
-  std::string to_string(const atom *const i) const noexcept;
-  std::string to_string(const std::map<std::string, expr> &items) const noexcept;
+  void write(std::ostream &os) const;        // writes a JSON description of the current solution into the given stream..
+  void write_binary(std::ostream &os) const; // writes the current solution into the given stream, in the binary format of 'solution_format.h'..
+  std::string to_string() const noexcept;    // returns a JSON description of the current solution..
 
 private:
   parser prs;
@@ -172,6 +174,7 @@ public:
   ov_theory ov_th; // the object-variable theory..
 
 private:
+  size_t n_items = 0; // the number of items created so far..
   var tmp_var;
   var ctr_var = TRUE_var;
 
@@ -1,4 +1,5 @@
 #include "declaration.h"
+#include "ast_cache.h"
 #include "statement.h"
 #include "expression.h"
 #include "core.h"
@@ -31,6 +32,14 @@ void typedef_declaration::declare(scope &scp) const
         t->types.insert({name, td});
 }
 
+void typedef_declaration::write(writer &w) const
+{
+    w.write_kind(TYPEDEF_DECLARATION);
+    w.write_string(name);
+    w.write_string(primitive_type);
+    w.write_expression(xpr);
+}
+
 enum_declaration::enum_declaration(const std::string &n, const std::vector<std::string> &es, const std::vector<std::vector<std::string>> &trs) : type_declaration(n), enums(es), type_refs(trs) {}
 enum_declaration::~enum_declaration() {}
 void enum_declaration::declare(scope &scp) const
@@ -62,9 +71,25 @@ void enum_declaration::refine(scope &scp) const
     }
 }
 
+void enum_declaration::write(writer &w) const
+{
+    w.write_kind(ENUM_DECLARATION);
+    w.write_string(name);
+    w.write_ids(enums);
+    w.write_size(type_refs.size());
+    for (const auto &tr : type_refs)
+        w.write_ids(tr);
+}
+
 variable_declaration::variable_declaration(const std::string &n, const expression *const e) : name(n), xpr(e) {}
 variable_declaration::~variable_declaration() { delete xpr; }
 
+void variable_declaration::write(writer &w) const
+{
+    w.write_string(name);
+    w.write_expression(xpr);
+}
+
 field_declaration::field_declaration(const std::vector<std::string> &tp, const std::vector<variable_declaration *> &ds) : field_type(tp), declarations(ds) {}
 field_declaration::~field_declaration()
 {
@@ -83,6 +108,12 @@ void field_declaration::refine(scope &scp) const
         scp.fields.insert({vd->name, new field(*tp, vd->name, vd->xpr)});
 }
 
+void field_declaration::write(writer &w) const
+{
+    w.write_ids(field_type);
+    w.write_all(declarations);
+}
+
 constructor_declaration::constructor_declaration(const std::vector<std::pair<std::vector<std::string>, std::string>> &pars, const std::vector<std::pair<std::string, std::vector<expression *>>> &il, const std::vector<statement *> &stmnts) : parameters(pars), init_list(il), statements(stmnts) {}
 constructor_declaration::~constructor_declaration()
 {
@@ -107,6 +138,18 @@ void constructor_declaration::refine(scope &scp) const
     static_cast<type &>(scp).constructors.push_back(new constructor(scp.get_core(), scp, args, init_list, statements));
 }
 
+void constructor_declaration::write(writer &w) const
+{
+    w.write_parameters(parameters);
+    w.write_size(init_list.size());
+    for (const auto &il : init_list)
+    {
+        w.write_string(il.first);
+        w.write_all(il.second);
+    }
+    w.write_all(statements);
+}
+
 method_declaration::method_declaration(const std::vector<std::string> &rt, const std::string &n, const std::vector<std::pair<std::vector<std::string>, std::string>> &pars, const std::vector<statement *> &stmnts) : return_type(rt), name(n), parameters(pars), statements(stmnts) {}
 method_declaration::~method_declaration()
 {
@@ -150,6 +193,14 @@ void method_declaration::refine(scope &scp) const
     }
 }
 
+void method_declaration::write(writer &w) const
+{
+    w.write_ids(return_type);
+    w.write_string(name);
+    w.write_parameters(parameters);
+    w.write_all(statements);
+}
+
 predicate_declaration::predicate_declaration(const std::string &n, const std::vector<std::pair<std::vector<std::string>, std::string>> &pars, const std::vector<std::vector<std::string>> &pl, const std::vector<statement *> &stmnts) : name(n), parameters(pars), predicate_list(pl), statements(stmnts) {}
 predicate_declaration::~predicate_declaration()
 {
@@ -196,6 +247,16 @@ void predicate_declaration::refine(scope &scp) const
     }
 }
 
+void predicate_declaration::write(writer &w) const
+{
+    w.write_string(name);
+    w.write_parameters(parameters);
+    w.write_size(predicate_list.size());
+    for (const auto &pl : predicate_list)
+        w.write_ids(pl);
+    w.write_all(statements);
+}
+
 class_declaration::class_declaration(const std::string &n, const std::vector<std::vector<std::string>> &bcs, const std::vector<field_declaration *> &fs, const std::vector<constructor_declaration *> &cs, const std::vector<method_declaration *> &ms, const std::vector<predicate_declaration *> &ps, const std::vector<type_declaration *> &ts) : type_declaration(n), base_classes(bcs), fields(fs), constructors(cs), methods(ms), predicates(ps), types(ts) {}
 class_declaration::~class_declaration()
 {
@@ -251,6 +312,20 @@ void class_declaration::refine(scope &scp) const
         t->refine(tp);
 }
 
+void class_declaration::write(writer &w) const
+{
+    w.write_kind(CLASS_DECLARATION);
+    w.write_string(name);
+    w.write_size(base_classes.size());
+    for (const auto &bc : base_classes)
+        w.write_ids(bc);
+    w.write_all(fields);
+    w.write_all(constructors);
+    w.write_all(methods);
+    w.write_all(predicates);
+    w.write_all(types);
+}
+
 compilation_unit::compilation_unit(const std::vector<method_declaration *> &ms, const std::vector<predicate_declaration *> &ps, const std::vector<type_declaration *> &ts, const std::vector<statement *> &stmnts) : methods(ms), predicates(ps), types(ts), statements(stmnts) {}
 compilation_unit::~compilation_unit()
 {
@@ -282,5 +357,13 @@ void compilation_unit::execute(const scope &scp, context &ctx) const
     for (const auto &stmnt : statements)
         stmnt->execute(scp, ctx);
 }
+
+void compilation_unit::write(writer &w) const
+{
+    w.write_all(methods);
+    w.write_all(predicates);
+    w.write_all(types);
+    w.write_all(statements);
+}
 }
 }
\ No newline at end of file
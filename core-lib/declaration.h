@@ -14,6 +14,7 @@ namespace ast
 
 class expression;
 class statement;
+class writer;
 
 class type_declaration
 {
@@ -24,6 +25,7 @@ public:
 
   virtual void declare(scope &) const {}
   virtual void refine(scope &) const {}
+  virtual void write(writer &w) const = 0; // writes the declaration in binary form..
 
 protected:
   const std::string name;
@@ -37,6 +39,7 @@ public:
   virtual ~typedef_declaration();
 
   void declare(scope &scp) const override;
+  void write(writer &w) const override;
 
 private:
   const std::string primitive_type;
@@ -52,6 +55,7 @@ public:
 
   void declare(scope &scp) const override;
   void refine(scope &scp) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::string> enums;
@@ -67,6 +71,8 @@ public:
   variable_declaration(const variable_declaration &orig) = delete;
   virtual ~variable_declaration();
 
+  void write(writer &w) const;
+
 private:
   const std::string name;
   const expression *const xpr;
@@ -80,6 +86,7 @@ public:
   virtual ~field_declaration();
 
   void refine(scope &scp) const;
+  void write(writer &w) const;
 
 private:
   const std::vector<std::string> field_type;
@@ -94,6 +101,7 @@ public:
   virtual ~constructor_declaration();
 
   void refine(scope &scp) const;
+  void write(writer &w) const;
 
 private:
   const std::vector<std::pair<std::vector<std::string>, std::string>> parameters;
@@ -109,6 +117,7 @@ public:
   virtual ~method_declaration();
 
   void refine(scope &scp) const;
+  void write(writer &w) const;
 
 private:
   const std::vector<std::string> return_type;
@@ -125,6 +134,7 @@ public:
   virtual ~predicate_declaration();
 
   void refine(scope &scp) const;
+  void write(writer &w) const;
 
 private:
   const std::string name;
@@ -142,6 +152,7 @@ public:
 
   void declare(scope &scp) const override;
   void refine(scope &scp) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::vector<std::string>> base_classes;
@@ -162,6 +173,7 @@ public:
   void declare(scope &scp) const;
   void refine(scope &scp) const;
   void execute(const scope &scp, context &ctx) const;
+  void write(writer &w) const;
 
 private:
   const std::vector<method_declaration *> methods;
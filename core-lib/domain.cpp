@@ -0,0 +1,20 @@
+#include "domain.h"
+#include "parser.h"
+#include "declaration.h"
+
+namespace lucy
+{
+
+domain::domain(const std::vector<std::string> &files)
+{
+    for (const auto &cu : parser::parse_all(files))
+        cus.push_back(cu);
+}
+
+domain::~domain()
+{
+    // we delete the compilation units..
+    for (const auto &cu : cus)
+        delete cu;
+}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+namespace lucy
+{
+
+namespace ast
+{
+class compilation_unit;
+}
+
+class domain
+{
+public:
+  domain(const std::vector<std::string> &files); // parses the given files..
+  domain(const domain &orig) = delete;
+  virtual ~domain();
+
+  const std::vector<const ast::compilation_unit *> &get_compilation_units() const { return cus; }
+
+private:
+  std::vector<const ast::compilation_unit *> cus; // the parsed compilation units (which can be read, at the same time, by any number of cores)..
+};
+}
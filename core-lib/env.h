@@ -8,6 +8,7 @@ namespace lucy
 {
 
 class core;
+class fact_loader;
 
 namespace ast
 {
@@ -26,6 +27,7 @@ class env
   friend class predicate;
   friend class constructor;
   friend class var_item;
+  friend class fact_loader;
   friend class ast::assignment_statement;
   friend class ast::local_field_statement;
   friend class ast::formula_statement;
@@ -1,4 +1,5 @@
 #include "expression.h"
+#include "ast_cache.h"
 #include "core.h"
 #include "item.h"
 #include "type.h"
@@ -18,6 +19,13 @@ cast_expression::cast_expression(const std::vector<std::string> &tp, const expre
 cast_expression::~cast_expression() { delete xpr; }
 expr cast_expression::evaluate(const scope &scp, context &ctx) const { return xpr->evaluate(scp, ctx); }
 
+void cast_expression::write(writer &w) const
+{
+    w.write_kind(CAST_EXPRESSION);
+    w.write_ids(cast_to_type);
+    w.write_expression(xpr);
+}
+
 constructor_expression::constructor_expression(const std::vector<std::string> &it, const std::vector<expression *> &es) : instance_type(it), expressions(es) {}
 constructor_expression::~constructor_expression()
 {
@@ -43,6 +51,13 @@ expr constructor_expression::evaluate(const scope &scp, context &ctx) const
     return static_cast<type *>(s)->get_constructor(par_types).new_instance(ctx, exprs);
 }
 
+void constructor_expression::write(writer &w) const
+{
+    w.write_kind(CONSTRUCTOR_EXPRESSION);
+    w.write_ids(instance_type);
+    w.write_all(expressions);
+}
+
 id_expression::id_expression(const std::vector<std::string> &is) : ids(is) {}
 id_expression::~id_expression() {}
 expr id_expression::evaluate(const scope &, context &ctx) const
@@ -53,6 +68,12 @@ expr id_expression::evaluate(const scope &, context &ctx) const
     return expr(static_cast<item *>(c_e));
 }
 
+void id_expression::write(writer &w) const
+{
+    w.write_kind(ID_EXPRESSION);
+    w.write_ids(ids);
+}
+
 function_expression::function_expression(const std::vector<std::string> &is, const std::string &fn, const std::vector<expression *> &es) : ids(is), function_name(fn), expressions(es) {}
 function_expression::~function_expression()
 {
@@ -88,26 +109,64 @@ expr function_expression::evaluate(const scope &scp, context &ctx) const
         return scp.get_core().new_bool(true);
 }
 
+void function_expression::write(writer &w) const
+{
+    w.write_kind(FUNCTION_EXPRESSION);
+    w.write_ids(ids);
+    w.write_string(function_name);
+    w.write_all(expressions);
+}
+
 string_literal_expression::string_literal_expression(const std::string &l) : literal(l) {}
 string_literal_expression::~string_literal_expression() {}
 expr string_literal_expression::evaluate(const scope &scp, context &) const { return scp.get_core().new_string(literal); }
 
+void string_literal_expression::write(writer &w) const
+{
+    w.write_kind(STRING_LITERAL_EXPRESSION);
+    w.write_string(literal);
+}
+
 int_literal_expression::int_literal_expression(const I &l) : literal(l) {}
 int_literal_expression::~int_literal_expression() {}
 expr int_literal_expression::evaluate(const scope &scp, context &) const { return scp.get_core().new_int(literal); }
 
+void int_literal_expression::write(writer &w) const
+{
+    w.write_kind(INT_LITERAL_EXPRESSION);
+    w.write_int(literal);
+}
+
 real_literal_expression::real_literal_expression(const rational &l) : literal(l) {}
 real_literal_expression::~real_literal_expression() {}
 expr real_literal_expression::evaluate(const scope &scp, context &) const { return scp.get_core().new_real(literal); }
 
+void real_literal_expression::write(writer &w) const
+{
+    w.write_kind(REAL_LITERAL_EXPRESSION);
+    w.write_rational(literal);
+}
+
 plus_expression::plus_expression(const expression *const e) : xpr(e) {}
 plus_expression::~plus_expression() { delete xpr; }
 expr plus_expression::evaluate(const scope &scp, context &ctx) const { return xpr->evaluate(scp, ctx); }
 
+void plus_expression::write(writer &w) const
+{
+    w.write_kind(PLUS_EXPRESSION);
+    w.write_expression(xpr);
+}
+
 minus_expression::minus_expression(const expression *const e) : xpr(e) {}
 minus_expression::~minus_expression() { delete xpr; }
 expr minus_expression::evaluate(const scope &scp, context &ctx) const { return scp.get_core().minus(xpr->evaluate(scp, ctx)); }
 
+void minus_expression::write(writer &w) const
+{
+    w.write_kind(MINUS_EXPRESSION);
+    w.write_expression(xpr);
+}
+
 range_expression::range_expression(const expression *const min_e, const expression *const max_e) : min_xpr(min_e), max_xpr(max_e) {}
 range_expression::~range_expression()
 {
@@ -123,6 +182,13 @@ expr range_expression::evaluate(const scope &scp, context &ctx) const
     return var;
 }
 
+void range_expression::write(writer &w) const
+{
+    w.write_kind(RANGE_EXPRESSION);
+    w.write_expression(min_xpr);
+    w.write_expression(max_xpr);
+}
+
 addition_expression::addition_expression(const std::vector<expression *> &es) : expressions(es) {}
 addition_expression::~addition_expression()
 {
@@ -137,6 +203,12 @@ expr addition_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().add(exprs);
 }
 
+void addition_expression::write(writer &w) const
+{
+    w.write_kind(ADDITION_EXPRESSION);
+    w.write_all(expressions);
+}
+
 subtraction_expression::subtraction_expression(const std::vector<expression *> &es) : expressions(es) {}
 subtraction_expression::~subtraction_expression()
 {
@@ -151,6 +223,12 @@ expr subtraction_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().sub(exprs);
 }
 
+void subtraction_expression::write(writer &w) const
+{
+    w.write_kind(SUBTRACTION_EXPRESSION);
+    w.write_all(expressions);
+}
+
 multiplication_expression::multiplication_expression(const std::vector<expression *> &es) : expressions(es) {}
 multiplication_expression::~multiplication_expression()
 {
@@ -165,6 +243,12 @@ expr multiplication_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().mult(exprs);
 }
 
+void multiplication_expression::write(writer &w) const
+{
+    w.write_kind(MULTIPLICATION_EXPRESSION);
+    w.write_all(expressions);
+}
+
 division_expression::division_expression(const std::vector<expression *> &es) : expressions(es) {}
 division_expression::~division_expression()
 {
@@ -179,10 +263,22 @@ expr division_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().div(exprs);
 }
 
+void division_expression::write(writer &w) const
+{
+    w.write_kind(DIVISION_EXPRESSION);
+    w.write_all(expressions);
+}
+
 bool_literal_expression::bool_literal_expression(const bool &l) : literal(l) {}
 bool_literal_expression::~bool_literal_expression() {}
 expr bool_literal_expression::evaluate(const scope &scp, context &) const { return scp.get_core().new_bool(literal); }
 
+void bool_literal_expression::write(writer &w) const
+{
+    w.write_kind(BOOL_LITERAL_EXPRESSION);
+    w.write_bool(literal);
+}
+
 eq_expression::eq_expression(const expression *const l, const expression *const r) : left(l), right(r) {}
 eq_expression::~eq_expression()
 {
@@ -196,6 +292,13 @@ expr eq_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().eq(l, r);
 }
 
+void eq_expression::write(writer &w) const
+{
+    w.write_kind(EQ_EXPRESSION);
+    w.write_expression(left);
+    w.write_expression(right);
+}
+
 neq_expression::neq_expression(const expression *const l, const expression *const r) : left(l), right(r) {}
 neq_expression::~neq_expression()
 {
@@ -209,6 +312,13 @@ expr neq_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().negate(scp.get_core().eq(l, r));
 }
 
+void neq_expression::write(writer &w) const
+{
+    w.write_kind(NEQ_EXPRESSION);
+    w.write_expression(left);
+    w.write_expression(right);
+}
+
 lt_expression::lt_expression(const expression *const l, const expression *const r) : left(l), right(r) {}
 lt_expression::~lt_expression()
 {
@@ -222,6 +332,13 @@ expr lt_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().lt(l, r);
 }
 
+void lt_expression::write(writer &w) const
+{
+    w.write_kind(LT_EXPRESSION);
+    w.write_expression(left);
+    w.write_expression(right);
+}
+
 leq_expression::leq_expression(const expression *const l, const expression *const r) : left(l), right(r) {}
 leq_expression::~leq_expression()
 {
@@ -235,6 +352,13 @@ expr leq_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().leq(l, r);
 }
 
+void leq_expression::write(writer &w) const
+{
+    w.write_kind(LEQ_EXPRESSION);
+    w.write_expression(left);
+    w.write_expression(right);
+}
+
 geq_expression::geq_expression(const expression *const l, const expression *const r) : left(l), right(r) {}
 geq_expression::~geq_expression()
 {
@@ -248,6 +372,13 @@ expr geq_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().geq(l, r);
 }
 
+void geq_expression::write(writer &w) const
+{
+    w.write_kind(GEQ_EXPRESSION);
+    w.write_expression(left);
+    w.write_expression(right);
+}
+
 gt_expression::gt_expression(const expression *const l, const expression *const r) : left(l), right(r) {}
 gt_expression::~gt_expression()
 {
@@ -261,6 +392,13 @@ expr gt_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().gt(l, r);
 }
 
+void gt_expression::write(writer &w) const
+{
+    w.write_kind(GT_EXPRESSION);
+    w.write_expression(left);
+    w.write_expression(right);
+}
+
 implication_expression::implication_expression(const expression *const l, const expression *const r) : left(l), right(r) {}
 implication_expression::~implication_expression()
 {
@@ -274,6 +412,13 @@ expr implication_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().disj({scp.get_core().negate(l), r});
 }
 
+void implication_expression::write(writer &w) const
+{
+    w.write_kind(IMPLICATION_EXPRESSION);
+    w.write_expression(left);
+    w.write_expression(right);
+}
+
 disjunction_expression::disjunction_expression(const std::vector<expression *> &es) : expressions(es) {}
 disjunction_expression::~disjunction_expression()
 {
@@ -288,6 +433,12 @@ expr disjunction_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().disj(exprs);
 }
 
+void disjunction_expression::write(writer &w) const
+{
+    w.write_kind(DISJUNCTION_EXPRESSION);
+    w.write_all(expressions);
+}
+
 conjunction_expression::conjunction_expression(const std::vector<expression *> &es) : expressions(es) {}
 conjunction_expression::~conjunction_expression()
 {
@@ -302,6 +453,12 @@ expr conjunction_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().conj(exprs);
 }
 
+void conjunction_expression::write(writer &w) const
+{
+    w.write_kind(CONJUNCTION_EXPRESSION);
+    w.write_all(expressions);
+}
+
 exct_one_expression::exct_one_expression(const std::vector<expression *> &es) : expressions(es) {}
 exct_one_expression::~exct_one_expression()
 {
@@ -316,8 +473,20 @@ expr exct_one_expression::evaluate(const scope &scp, context &ctx) const
     return scp.get_core().exct_one(exprs);
 }
 
+void exct_one_expression::write(writer &w) const
+{
+    w.write_kind(EXCT_ONE_EXPRESSION);
+    w.write_all(expressions);
+}
+
 not_expression::not_expression(const expression *const e) : xpr(e) {}
 not_expression::~not_expression() { delete xpr; }
 expr not_expression::evaluate(const scope &scp, context &ctx) const { return scp.get_core().negate(xpr->evaluate(scp, ctx)); }
+
+void not_expression::write(writer &w) const
+{
+    w.write_kind(NOT_EXPRESSION);
+    w.write_expression(xpr);
+}
 }
 }
\ No newline at end of file
@@ -14,6 +14,8 @@ class expr;
 namespace ast
 {
 
+class writer;
+
 class expression
 {
 public:
@@ -22,6 +24,7 @@ public:
   virtual ~expression();
 
   virtual expr evaluate(const scope &scp, context &ctx) const = 0;
+  virtual void write(writer &w) const = 0; // writes the expression in binary form..
 };
 
 class cast_expression : public expression
@@ -32,6 +35,7 @@ public:
   virtual ~cast_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::string> cast_to_type;
@@ -46,6 +50,7 @@ public:
   virtual ~constructor_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::string> instance_type;
@@ -60,6 +65,7 @@ public:
   virtual ~id_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::string> ids;
@@ -73,6 +79,7 @@ public:
   virtual ~function_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::string> ids;
@@ -88,6 +95,7 @@ public:
   virtual ~string_literal_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::string literal;
@@ -101,6 +109,7 @@ public:
   virtual ~int_literal_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const smt::I literal;
@@ -114,6 +123,7 @@ public:
   virtual ~real_literal_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const smt::rational literal;
@@ -127,6 +137,7 @@ public:
   virtual ~plus_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const xpr;
@@ -140,6 +151,7 @@ public:
   virtual ~minus_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const xpr;
@@ -153,6 +165,7 @@ public:
   virtual ~range_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const min_xpr;
@@ -167,6 +180,7 @@ public:
   virtual ~addition_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<expression *> expressions;
@@ -180,6 +194,7 @@ public:
   virtual ~subtraction_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<expression *> expressions;
@@ -193,6 +208,7 @@ public:
   virtual ~multiplication_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<expression *> expressions;
@@ -206,6 +222,7 @@ public:
   virtual ~division_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<expression *> expressions;
@@ -219,6 +236,7 @@ public:
   virtual ~bool_literal_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const bool literal;
@@ -232,6 +250,7 @@ public:
   virtual ~eq_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const left;
@@ -246,6 +265,7 @@ public:
   virtual ~neq_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const left;
@@ -260,6 +280,7 @@ public:
   virtual ~lt_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const left;
@@ -274,6 +295,7 @@ public:
   virtual ~leq_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const left;
@@ -288,6 +310,7 @@ public:
   virtual ~geq_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const left;
@@ -302,6 +325,7 @@ public:
   virtual ~gt_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const left;
@@ -316,6 +340,7 @@ public:
   virtual ~implication_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const left;
@@ -330,6 +355,7 @@ public:
   virtual ~disjunction_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<expression *> expressions;
@@ -343,6 +369,7 @@ public:
   virtual ~conjunction_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<expression *> expressions;
@@ -356,6 +383,7 @@ public:
   virtual ~exct_one_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<expression *> expressions;
@@ -369,6 +397,7 @@ public:
   virtual ~not_expression();
 
   expr evaluate(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const xpr;
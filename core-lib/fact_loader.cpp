@@ -0,0 +1,248 @@
+#include "fact_loader.h"
+#include "core.h"
+#include "predicate.h"
+#include "field.h"
+#include "atom.h"
+#include <queue>
+#include <unordered_set>
+
+namespace lucy
+{
+
+fact_loader::fact_loader(core &cr) : cr(cr) {}
+fact_loader::~fact_loader() {}
+
+void fact_loader::load(std::istream &is)
+{
+    lexer lex(is);
+    tks.clear();
+    do
+        tks.push_back(lex.next());
+    while (tks.back().sym != EOF_ID);
+    pos = 0;
+
+    while (tks[pos].sym != EOF_ID)
+        switch (tks[pos].sym)
+        {
+        case FACT_ID:
+        case GOAL_ID:
+            header();
+            break;
+        default:
+            if (!pred)
+                error("expected either 'fact' or 'goal'..");
+            row();
+        }
+
+    std::vector<token>().swap(tks);
+}
+
+void fact_loader::header()
+{
+    line = tks[pos].start_line;
+    is_fact = next().sym == FACT_ID;
+
+    // the (possibly scoped) predicate..
+    std::vector<std::string> ids;
+    do
+    {
+        if (tks[pos].sym != ID_ID)
+            error("expected identifier..");
+        ids.push_back(next().str);
+    } while (tks[pos].sym == DOT_ID && next().sym == DOT_ID);
+
+    tau = nullptr;
+    try
+    {
+        if (ids.size() == 1)
+        {
+            pred = &cr.get_predicate(ids.back());
+            if (&pred->get_scope() != &cr)
+                error("predicate '" + ids.back() + "' requires a scope..");
+        }
+        else
+        {
+            env *c_scope = &cr;
+            for (size_t i = 0; i < ids.size() - 1; ++i)
+                c_scope = &*c_scope->get(ids[i]);
+            tau = static_cast<item *>(c_scope);
+            pred = &tau->tp.get_predicate(ids.back());
+        }
+    }
+    catch (const std::out_of_range &)
+    {
+        error("cannot find predicate '" + ids.back() + "'..");
+    }
+
+    // the columns..
+    cols.clear();
+    std::unordered_set<std::string> c_cols;
+    if (tks[pos].sym != LPAREN_ID || next().sym != LPAREN_ID)
+        error("expected '('..");
+    if (tks[pos].sym != RPAREN_ID)
+        do
+        {
+            if (tks[pos].sym != ID_ID)
+                error("expected identifier..");
+            const std::string &arg = tks[pos].str;
+            if (!c_cols.insert(arg).second)
+                error("duplicate argument '" + arg + "'..");
+            try
+            {
+                const field &f = pred->get_field(arg);
+                if (f.synthetic)
+                    error("cannot assign argument '" + arg + "'..");
+                cols.push_back(&f);
+                next();
+            }
+            catch (const std::out_of_range &)
+            {
+                error("cannot find argument '" + arg + "'..");
+            }
+        } while (tks[pos].sym == COMMA_ID && next().sym == COMMA_ID);
+    if (tks[pos].sym != RPAREN_ID || next().sym != RPAREN_ID)
+        error("expected ')'..");
+    if (!at_line_end())
+        error("expected a new line..");
+
+    // the arguments which are not columns are initialized as in 'formula_statement'..
+    others.clear();
+    std::queue<predicate *> q;
+    q.push(pred);
+    while (!q.empty())
+    {
+        for (const auto &arg : q.front()->get_args())
+            if (c_cols.insert(arg->name).second)
+                others.push_back(arg);
+        for (const auto &sp : q.front()->get_supertypes())
+            q.push(static_cast<predicate *>(sp));
+        q.pop();
+    }
+
+    // the variables of the atoms of this section are created one row at a time, we reserve the room for all of them at once..
+    size_t n_rows = 0;
+    int c_line = line;
+    for (size_t i = pos; tks[i].sym != EOF_ID && tks[i].sym != FACT_ID && tks[i].sym != GOAL_ID; ++i)
+        if (tks[i].start_line != c_line)
+        {
+            c_line = tks[i].start_line;
+            n_rows++;
+        }
+    size_t n_bools = 1; // the 'sigma' variable of the atom..
+    size_t n_ariths = 0;
+    for (const auto &arg : others)
+        if (arg->tp.name.compare(BOOL_KEYWORD) == 0)
+            n_bools++;
+        else if (arg->tp.name.compare(INT_KEYWORD) == 0 || arg->tp.name.compare(REAL_KEYWORD) == 0)
+            n_ariths++;
+    cr.sat_cr.reserve(n_rows * n_bools);
+    cr.la_th.reserve(n_rows * n_ariths);
+}
+
+void fact_loader::row()
+{
+    line = tks[pos].start_line;
+    std::vector<expr> vals;
+    vals.reserve(cols.size());
+    for (size_t i = 0; i < cols.size(); ++i)
+    {
+        if (i > 0 && (tks[pos].sym != COMMA_ID || next().sym != COMMA_ID))
+            error("expected ','..");
+        vals.push_back(value(cols[i]->tp));
+    }
+    if (!at_line_end())
+        error("expected a new line..");
+
+    context c_scope(tau ? static_cast<env *>(tau) : &cr);
+    atom *a = static_cast<atom *>(&*pred->new_instance(c_scope));
+    if (tau)
+        a->items.insert({TAU, expr(tau)});
+    for (size_t i = 0; i < cols.size(); ++i)
+        a->items.insert({cols[i]->name, vals[i]});
+    for (const auto &arg : others)
+    {
+        type &tp = const_cast<type &>(arg->tp);
+        if (tp.primitive)
+            a->items.insert({arg->name, tp.new_instance(c_scope)});
+        else
+            a->items.insert({arg->name, tp.new_existential()});
+    }
+
+    if (is_fact)
+        cr.new_fact(*a);
+    else
+        cr.new_goal(*a);
+}
+
+expr fact_loader::value(const type &tp)
+{
+    bool negative = false;
+    if (tks[pos].sym == MINUS_ID)
+    {
+        next();
+        negative = true;
+    }
+
+    if (at_line_end())
+        error("expected a value..");
+    const token &tk = tks[pos];
+    switch (tk.sym)
+    {
+    case IntLiteral_ID:
+        if (tp.name.compare(INT_KEYWORD) == 0)
+        {
+            next();
+            return cr.new_int(negative ? -tk.val.numerator() : tk.val.numerator());
+        }
+        else if (tp.name.compare(REAL_KEYWORD) == 0)
+        {
+            next();
+            return cr.new_real(negative ? rational::ZERO - tk.val : tk.val);
+        }
+        break;
+    case RealLiteral_ID:
+        if (tp.name.compare(REAL_KEYWORD) == 0)
+        {
+            next();
+            return cr.new_real(negative ? rational::ZERO - tk.val : tk.val);
+        }
+        break;
+    case StringLiteral_ID:
+        if (!negative && tp.name.compare(STRING_KEYWORD) == 0)
+        {
+            next();
+            return cr.new_string(tk.str);
+        }
+        break;
+    case TRUE_ID:
+    case FALSE_ID:
+        if (!negative && tp.name.compare(BOOL_KEYWORD) == 0)
+        {
+            next();
+            return cr.new_bool(tk.sym == TRUE_ID);
+        }
+        break;
+    case ID_ID:
+        if (!negative)
+        {
+            const auto at_itm = cr.items.find(tk.str);
+            if (at_itm == cr.items.end())
+                error("cannot find '" + tk.str + "'..");
+            if (tp.is_assignable_from(at_itm->second->tp))
+            {
+                next();
+                return at_itm->second;
+            }
+        }
+        break;
+    default:
+        error("expected a value..");
+    }
+    error("expected a value of type '" + tp.name + "'..");
+    return expr(nullptr);
+}
+
+bool fact_loader::at_line_end() const { return tks[pos].sym == EOF_ID || tks[pos].start_line != line; }
+
+void fact_loader::error(const std::string &err) { throw std::invalid_argument("[" + std::to_string(tks[pos].start_line) + ", " + std::to_string(tks[pos].start_pos) + "] " + err); }
+}
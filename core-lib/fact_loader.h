@@ -0,0 +1,57 @@
+#pragma once
+
+#include "lexer.h"
+#include "context.h"
+#include <istream>
+
+namespace lucy
+{
+
+class core;
+class item;
+class type;
+class field;
+class predicate;
+
+// loads, in bulk, the atoms listed into a facts file, without building (nor executing) any statement..
+// a facts file is made of sections, each starting with a 'fact' (or 'goal') header which names a (possibly scoped) predicate and some of its arguments:
+//
+//     fact Loc(x, y, name)
+//     0.5, 0.0, "n0"
+//     1.5, 1.0, "n1"
+//     goal agent.At(l)
+//     l0
+//
+// each following line (until the next header) creates a new atom of that predicate whose arguments take the given values (either literals or names of the core's items), in the given order..
+// arguments which are not listed in the header are initialized as in 'formula_statement'..
+// the atoms are still created one row at a time, yet the room for the sat and the linear-arithmetic variables of a whole section is reserved once, when reading its header..
+class fact_loader
+{
+public:
+  fact_loader(core &cr);
+  fact_loader(const fact_loader &orig) = delete;
+  virtual ~fact_loader();
+
+  void load(std::istream &is);
+
+private:
+  void header();                             // reads a section header..
+  void row();                                // reads a row of the current section, creating the corresponding atom..
+  expr value(const type &tp);                // reads a value of the given type..
+  const token &next() { return tks[pos++]; } // consumes the current token..
+  bool at_line_end() const;                  // checks whether the current token starts a new line (or is the end of the file)..
+
+  void error(const std::string &err);
+
+private:
+  core &cr;
+  std::vector<token> tks;            // the tokens of the file..
+  size_t pos = 0;                    // the current position within 'tks'..
+  int line = 0;                      // the line of the current row..
+  bool is_fact = true;               // whether the atoms of the current section are facts or goals..
+  predicate *pred = nullptr;         // the predicate of the current section..
+  item *tau = nullptr;               // the scope of the atoms of the current section (a nullptr if the scope is the core)..
+  std::vector<const field *> cols;   // the arguments of the current section, in the order of the columns..
+  std::vector<const field *> others; // the arguments of the predicate (and of its super-predicates) which are not columns of the current section..
+};
+}
@@ -8,7 +8,7 @@
 namespace lucy
 {
 
-item::item(core &cr, const context ctx, const type &tp) : env(cr, ctx), tp(tp) {}
+item::item(core &cr, const context ctx, const type &tp, const item_kind &kind) : env(cr, ctx), tp(tp), kind(kind), id(cr.n_items++) {}
 
 item::~item() {}
 
@@ -16,8 +16,8 @@ var item::eq(item &i) noexcept
 {
 	if (this == &i)
 		return TRUE_var;
-	else if (var_item *ei = dynamic_cast<var_item *>(&i))
-		return ei->eq(*this);
+	else if (i.kind == VAR_ITEM)
+		return static_cast<var_item &>(i).eq(*this);
 	else
 	{
 		std::vector<lit> eqs;
@@ -46,8 +46,8 @@ bool item::equates(const item &i) const noexcept
 {
 	if (this == &i)
 		return true;
-	else if (const var_item *ei = dynamic_cast<const var_item *>(&i))
-		return ei->equates(*this);
+	else if (i.kind == VAR_ITEM)
+		return static_cast<const var_item &>(i).equates(*this);
 	else
 	{
 		std::queue<const type *> q;
@@ -66,15 +66,15 @@ bool item::equates(const item &i) const noexcept
 	}
 }
 
-bool_item::bool_item(core &cr, const lit &l) : item(cr, &cr, cr.get_type(BOOL_KEYWORD)), l(l) {}
+bool_item::bool_item(core &cr, const lit &l) : item(cr, &cr, cr.get_type(BOOL_KEYWORD), BOOL_ITEM), l(l) {}
 bool_item::~bool_item() {}
 
 var bool_item::eq(item &i) noexcept
 {
 	if (this == &i)
 		return TRUE_var;
-	else if (bool_item *be = dynamic_cast<bool_item *>(&i))
-		return cr.sat_cr.new_eq(l, be->l);
+	else if (i.kind == BOOL_ITEM)
+		return cr.sat_cr.new_eq(l, static_cast<bool_item &>(i).l);
 	else
 		return FALSE_var;
 }
@@ -83,25 +83,28 @@ bool bool_item::equates(const item &i) const noexcept
 {
 	if (this == &i)
 		return true;
-	else if (const bool_item *be = dynamic_cast<const bool_item *>(&i))
+	else if (i.kind == BOOL_ITEM)
 	{
 		lbool c_val = cr.sat_cr.value(l);
-		lbool i_val = cr.sat_cr.value(be->l);
+		lbool i_val = cr.sat_cr.value(static_cast<const bool_item &>(i).l);
 		return c_val == i_val || c_val == Undefined || i_val == Undefined;
 	}
 	else
 		return false;
 }
 
-arith_item::arith_item(core &cr, const type &t, const lin &l) : item(cr, &cr, t), l(l) { assert(&t == &cr.get_type(INT_KEYWORD) || &t == &cr.get_type(REAL_KEYWORD)); }
+arith_item::arith_item(core &cr, const type &t, const lin &l) : item(cr, &cr, t, ARITH_ITEM), l(l) { assert(&t == &cr.get_type(INT_KEYWORD) || &t == &cr.get_type(REAL_KEYWORD)); }
 arith_item::~arith_item() {}
 
 var arith_item::eq(item &i) noexcept
 {
 	if (this == &i)
 		return TRUE_var;
-	else if (arith_item *ae = dynamic_cast<arith_item *>(&i))
-		return cr.sat_cr.new_conj({cr.la_th.new_leq(l, ae->l), cr.la_th.new_geq(l, ae->l)});
+	else if (i.kind == ARITH_ITEM)
+	{
+		const lin &i_l = static_cast<arith_item &>(i).l;
+		return cr.sat_cr.new_conj({cr.la_th.new_leq(l, i_l), cr.la_th.new_geq(l, i_l)});
+	}
 	else
 		return FALSE_var;
 }
@@ -110,21 +113,24 @@ bool arith_item::equates(const item &i) const noexcept
 {
 	if (this == &i)
 		return true;
-	else if (const arith_item *ae = dynamic_cast<const arith_item *>(&i))
-		return cr.la_th.ub(l) >= cr.la_th.lb(ae->l) && cr.la_th.lb(l) <= cr.la_th.ub(ae->l); // the two intervals intersect..
+	else if (i.kind == ARITH_ITEM)
+	{
+		const lin &i_l = static_cast<const arith_item &>(i).l;
+		return cr.la_th.ub(l) >= cr.la_th.lb(i_l) && cr.la_th.lb(l) <= cr.la_th.ub(i_l); // the two intervals intersect..
+	}
 	else
 		return false;
 }
 
-string_item::string_item(core &cr, const std::string &l) : item(cr, &cr, cr.get_type(STRING_KEYWORD)), l(l) {}
+string_item::string_item(core &cr, const std::string &l) : item(cr, &cr, cr.get_type(STRING_KEYWORD), STRING_ITEM), l(l) {}
 string_item::~string_item() {}
 
 var string_item::eq(item &i) noexcept
 {
 	if (this == &i)
 		return TRUE_var;
-	else if (string_item *se = dynamic_cast<string_item *>(&i))
-		return l.compare(se->l) == 0 ? TRUE_var : FALSE_var;
+	else if (i.kind == STRING_ITEM)
+		return l.compare(static_cast<string_item &>(i).l) == 0 ? TRUE_var : FALSE_var;
 	else
 		return FALSE_var;
 }
@@ -133,13 +139,13 @@ bool string_item::equates(const item &i) const noexcept
 {
 	if (this == &i)
 		return true;
-	else if (const string_item *se = dynamic_cast<const string_item *>(&i))
-		return l.compare(se->l) == 0;
+	else if (i.kind == STRING_ITEM)
+		return l.compare(static_cast<const string_item &>(i).l) == 0;
 	else
 		return false;
 }
 
-var_item::var_item(core &cr, const type &t, var ev) : item(cr, &cr, t), ev(ev) {}
+var_item::var_item(core &cr, const type &t, var ev) : item(cr, &cr, t, VAR_ITEM), ev(ev) {}
 var_item::~var_item() {}
 
 expr var_item::get(const std::string &name) const
@@ -174,8 +180,8 @@ var var_item::eq(item &i) noexcept
 {
 	if (this == &i)
 		return TRUE_var;
-	else if (var_item *ee = dynamic_cast<var_item *>(&i))
-		return cr.ov_th.eq(ev, ee->ev);
+	else if (i.kind == VAR_ITEM)
+		return cr.ov_th.eq(ev, static_cast<var_item &>(i).ev);
 	else
 		return cr.ov_th.allows(ev, i);
 }
@@ -184,10 +190,10 @@ bool var_item::equates(const item &i) const noexcept
 {
 	if (this == &i)
 		return true;
-	else if (const var_item *ei = dynamic_cast<const var_item *>(&i))
+	else if (i.kind == VAR_ITEM)
 	{
 		std::unordered_set<var_value *> c_vals = cr.ov_th.value(ev);
-		std::unordered_set<var_value *> i_vals = cr.ov_th.value(ei->ev);
+		std::unordered_set<var_value *> i_vals = cr.ov_th.value(static_cast<const var_item &>(i).ev);
 		for (const auto &c_v : c_vals)
 			if (i_vals.find(c_v) != i_vals.end())
 				return true;
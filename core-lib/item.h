@@ -12,10 +12,19 @@ namespace lucy
 
 class type;
 
+enum item_kind
+{
+	OBJECT_ITEM, // an instance of a user defined type (or an atom)..
+	BOOL_ITEM,   // a 'bool_item'..
+	ARITH_ITEM,  // an 'arith_item'..
+	STRING_ITEM, // a 'string_item'..
+	VAR_ITEM     // a 'var_item'..
+};
+
 class item : public env, public var_value
 {
   public:
-	item(core &cr, const context ctx, const type &tp);
+	item(core &cr, const context ctx, const type &tp, const item_kind &kind = OBJECT_ITEM);
 	item(const item &orig) = delete;
 	virtual ~item();
 
@@ -24,6 +33,8 @@ class item : public env, public var_value
 
   public:
 	const type &tp;
+	const item_kind kind; // the kind of the item, allows static downcasts in place of the 'dynamic_cast' ones..
+	const size_t id;      // a sequential identifier of the item, assigned in creation order (unlike the item's address, it does not change across runs)..
 };
 
 class bool_item : public item
@@ -1,5 +1,7 @@
 #include "lexer.h"
-#include <iostream>
+#include <cstring>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 
 namespace lucy
@@ -7,1083 +9,325 @@ namespace lucy
 
 bool is_id_part(const char &ch) { return ch == '_' || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9'); }
 
-lexer::lexer(std::istream &is) : is(is) {}
+symbol keyword(const char *s, const size_t &n)
+{
+    const auto is = [s, n](const char *kw) { return std::strlen(kw) == n && std::memcmp(s, kw, n) == 0; };
+    switch (s[0])
+    {
+    case 'b':
+        return is("bool") ? BOOL_ID : ID_ID;
+    case 'c':
+        return is("class") ? CLASS_ID : ID_ID;
+    case 'e':
+        return is("enum") ? ENUM_ID : ID_ID;
+    case 'f':
+        return is("fact") ? FACT_ID : is("false") ? FALSE_ID : ID_ID;
+    case 'g':
+        return is("goal") ? GOAL_ID : ID_ID;
+    case 'i':
+        return is("int") ? INT_ID : ID_ID;
+    case 'n':
+        return is("new") ? NEW_ID : ID_ID;
+    case 'o':
+        return is("or") ? OR_ID : ID_ID;
+    case 'p':
+        return is("predicate") ? PREDICATE_ID : ID_ID;
+    case 'r':
+        return is("real") ? REAL_ID : is("return") ? RETURN_ID : ID_ID;
+    case 's':
+        return is("string") ? STRING_ID : ID_ID;
+    case 't':
+        return is("typedef") ? TYPEDEF_ID : is("true") ? TRUE_ID : ID_ID; // notice that 'this' is scanned as an identifier..
+    case 'v':
+        return is("void") ? VOID_ID : ID_ID;
+    default:
+        return ID_ID;
+    }
+}
+
+lexer::lexer(std::istream &is)
+{
+    // we read the whole input at once, rather than character by character..
+    std::ostringstream ss;
+    ss << is.rdbuf();
+    buf = ss.str();
+    p = buf.data();
+    end = p + buf.size();
+}
 
 lexer::~lexer() {}
 
-token *lexer::next()
+token lexer::next()
 {
-    ch = static_cast<char>(is.get());
-    switch (ch)
-    {
-    case '"': // string literal
+    skip_whitespaces();
+    start_line = end_line;
+    start_pos = end_pos;
+
+    if (p == end)
+        return mk_token(EOF_ID);
+
+    switch (*p)
     {
-        std::vector<char> str;
-        end_pos++;
-        while (true)
-        {
-            ch = static_cast<char>(is.get());
-            switch (ch)
-            {
-            case '"':
-                end_pos++;
-                return mk_string_token(std::string(str.begin(), str.end()));
-            case '\\':
-                // read escaped char
-                end_pos++;
-                ch = static_cast<char>(is.get());
-                str.push_back(ch);
-                break;
-            case '\r':
-            case '\n':
-                error("newline in string literal..");
-            case EOF:
-                error("invalid string literal..");
-            default:
-                str.push_back(ch);
-            }
-        }
-    }
+    case '"':
+        return finish_string();
     case '/':
+        p++;
         end_pos++;
-        ch = static_cast<char>(is.get());
-        switch (ch)
-        {
-        case '/': // in single-line comment
-            end_pos++;
-            while (true)
-            {
-                ch = static_cast<char>(is.get());
-                end_pos++;
-                switch (ch)
-                {
-                case '\r':
-                    if (is.get() != '\n')
-                        is.unget();
-                case '\n':
-                    end_line++;
-                    end_pos = 0;
-                    return next();
-                case EOF:
-                    return mk_token(EOF_ID);
-                }
-            }
-        case '*': // in multi-line comment
-            end_pos++;
-            while (true)
-            {
-                ch = static_cast<char>(is.get());
-                end_pos++;
-                switch (ch)
-                {
-                case '*':
-                    ch = static_cast<char>(is.get());
-                    end_pos++;
-                    if (ch == '/')
-                        return next();
-                    break;
-                case '\r':
-                    if (is.get() != '\n')
-                        is.unget();
-                case '\n':
-                    end_line++;
-                    end_pos = 0;
-                }
-            }
-        }
-        is.unget();
-        end_pos--;
         return mk_token(SLASH_ID);
     case '=':
+        p++;
         end_pos++;
-        ch = static_cast<char>(is.get());
-        if (ch == '=')
+        if (peek() == '=')
         {
+            p++;
             end_pos++;
             return mk_token(EQEQ_ID);
         }
-        is.unget();
         return mk_token(EQ_ID);
     case '>':
+        p++;
         end_pos++;
-        ch = static_cast<char>(is.get());
-        if (ch == '=')
+        if (peek() == '=')
         {
+            p++;
             end_pos++;
             return mk_token(GTEQ_ID);
         }
-        is.unget();
         return mk_token(GT_ID);
     case '<':
+        p++;
         end_pos++;
-        ch = static_cast<char>(is.get());
-        if (ch == '=')
+        if (peek() == '=')
         {
+            p++;
             end_pos++;
             return mk_token(LTEQ_ID);
         }
-        is.unget();
         return mk_token(LT_ID);
     case '+':
+        p++;
         end_pos++;
         return mk_token(PLUS_ID);
     case '-':
+        p++;
         end_pos++;
         return mk_token(MINUS_ID);
     case '|':
+        p++;
         end_pos++;
         return mk_token(BAR_ID);
     case '&':
+        p++;
         end_pos++;
         return mk_token(AMP_ID);
     case '^':
+        p++;
         end_pos++;
         return mk_token(CARET_ID);
     case '!':
+        p++;
         end_pos++;
         return mk_token(BANG_ID);
     case '.':
+        if (peek(1) >= '0' && peek(1) <= '9') // in a number literal..
+            return finish_number();
+        p++;
         end_pos++;
-        ch = static_cast<char>(is.get());
-        end_pos++;
-        if ('0' <= ch && ch <= '9') // in a number literal..
-        {
-            std::vector<char> dec;
-            dec.push_back(ch);
-            while (true)
-            {
-                ch = static_cast<char>(is.get());
-                switch (ch)
-                {
-                case '0':
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                case '8':
-                case '9':
-                    end_pos++;
-                    dec.push_back(ch);
-                    break;
-                case '.':
-                    error("invalid numeric literal..");
-                default:
-                    is.unget();
-                    return mk_rational_token("", std::string(dec.begin(), dec.end()));
-                }
-            }
-        }
-        is.unget();
-        end_pos--;
         return mk_token(DOT_ID);
     case ',':
+        p++;
         end_pos++;
         return mk_token(COMMA_ID);
     case ';':
+        p++;
         end_pos++;
         return mk_token(SEMICOLON_ID);
     case ':':
+        p++;
         end_pos++;
         return mk_token(COLON_ID);
     case '(':
+        p++;
         end_pos++;
         return mk_token(LPAREN_ID);
     case ')':
+        p++;
         end_pos++;
         return mk_token(RPAREN_ID);
     case '[':
+        p++;
         end_pos++;
         return mk_token(LBRACKET_ID);
     case ']':
+        p++;
         end_pos++;
         return mk_token(RBRACKET_ID);
     case '{':
+        p++;
         end_pos++;
         return mk_token(LBRACE_ID);
     case '}':
+        p++;
         end_pos++;
         return mk_token(RBRACE_ID);
-    case '0': // in a number literal..
-    case '1':
-    case '2':
-    case '3':
-    case '4':
-    case '5':
-    case '6':
-    case '7':
-    case '8':
-    case '9':
-    {
-        end_pos++;
-        std::vector<char> intgr; // the integer part..
-        intgr.push_back(ch);
-        while (true)
+    default:
+        if (*p >= '0' && *p <= '9')
+            return finish_number();
+        if (is_id_part(*p))
+            return finish_id();
+        error("invalid token..");
+        return mk_token(EOF_ID);
+    }
+}
+
+void lexer::skip_whitespaces()
+{
+    while (p != end)
+        switch (*p)
         {
-            ch = static_cast<char>(is.get());
-            switch (ch)
+        case '\t':
+            p++;
+            end_pos += 4 - (end_pos % 4);
+            break;
+        case ' ':
+            p++;
+            end_pos++;
+            break;
+        case '\r':
+            if (peek(1) == '\n')
+                p++;
+            [[fallthrough]];
+        case '\n':
+            p++;
+            end_line++;
+            end_pos = 0;
+            break;
+        case '/':
+            if (peek(1) == '/') // in single-line comment..
             {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-                end_pos++;
-                intgr.push_back(ch);
-                break;
-            case '.':
+                p += 2;
+                end_pos += 2;
+                while (p != end && *p != '\r' && *p != '\n')
+                {
+                    p++;
+                    end_pos++;
+                }
+            }
+            else if (peek(1) == '*') // in multi-line comment..
             {
-                end_pos++;
-                std::vector<char> dcml; // the decimal part..
+                start_line = end_line;
+                start_pos = end_pos;
+                p += 2;
+                end_pos += 2;
                 while (true)
                 {
-                    ch = static_cast<char>(is.get());
-                    switch (ch)
+                    if (p == end)
+                        error("unterminated comment..");
+                    else if (*p == '*' && peek(1) == '/')
                     {
-                    case '0':
-                    case '1':
-                    case '2':
-                    case '3':
-                    case '4':
-                    case '5':
-                    case '6':
-                    case '7':
-                    case '8':
-                    case '9':
-                        end_pos++;
-                        dcml.push_back(ch);
+                        p += 2;
+                        end_pos += 2;
                         break;
-                    case '.':
-                        error("invalid numeric literal..");
-                        break;
-                    default:
-                        is.unget();
-                        return mk_rational_token(std::string(intgr.begin(), intgr.end()), std::string(dcml.begin(), dcml.end()));
+                    }
+                    else if (*p == '\r' || *p == '\n')
+                    {
+                        if (*p == '\r' && peek(1) == '\n')
+                            p++;
+                        p++;
+                        end_line++;
+                        end_pos = 0;
+                    }
+                    else
+                    {
+                        p++;
+                        end_pos++;
                     }
                 }
             }
-            default:
-                is.unget();
-                return mk_integer_token(std::string(intgr.begin(), intgr.end()));
-            }
-        }
-    }
-    case 'b':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'o')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'o')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'l')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(BOOL_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'c':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'l')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'a')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 's')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 's')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(CLASS_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'e':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'n')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'u')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'm')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(ENUM_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'f':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'a')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        switch (ch)
-        {
-        case 'c':
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 't')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (!is_id_part(ch))
-            {
-                is.unget();
-                return mk_token(FACT_ID);
-            }
             else
-            {
-                is.unget();
-                return finish_id(str);
-            }
-        case 'l':
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 's')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'e')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (!is_id_part(ch))
-            {
-                is.unget();
-                return mk_token(FALSE_ID);
-            }
-            else
-            {
-                is.unget();
-                return finish_id(str);
-            }
-        }
-        is.unget();
-        return finish_id(str);
-    }
-    case 'g':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'o')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'a')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'l')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(GOAL_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'i':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'n')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 't')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(INT_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'n':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'e')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'w')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(NEW_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'o':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'r')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(OR_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'p':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'r')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'e')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'd')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'i')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'c')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'a')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 't')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'e')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(PREDICATE_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 'r':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'e')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        switch (ch)
-        {
-        case 'a':
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'l')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (!is_id_part(ch))
-            {
-                is.unget();
-                return mk_token(REAL_ID);
-            }
-            else
-            {
-                is.unget();
-                return finish_id(str);
-            }
-        case 't':
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'u')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'r')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'n')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (!is_id_part(ch))
-            {
-                is.unget();
-                return mk_token(RETURN_ID);
-            }
-            else
-            {
-                is.unget();
-                return finish_id(str);
-            }
-        }
-        is.unget();
-        return finish_id(str);
-    }
-    case 's':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 't')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'r')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'i')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'n')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'g')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(STRING_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
-    }
-    case 't':
-    {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        switch (ch)
-        {
-        case 'r':
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'u')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'e')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (!is_id_part(ch))
-            {
-                is.unget();
-                return mk_token(TRUE_ID);
-            }
-            else
-            {
-                is.unget();
-                return finish_id(str);
-            }
-        case 'y':
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'p')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'e')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'd')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'e')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (ch != 'f')
-            {
-                is.unget();
-                return finish_id(str);
-            }
-            end_pos++;
-            str.push_back(ch);
-            ch = static_cast<char>(is.get());
-            if (!is_id_part(ch))
-            {
-                is.unget();
-                return mk_token(TYPEDEF_ID);
-            }
-            else
-            {
-                is.unget();
-                return finish_id(str);
-            }
+                return;
+            break;
+        default:
+            return;
         }
-        is.unget();
-        return finish_id(str);
-    }
-    case 'v':
+}
+
+token lexer::finish_id()
+{
+    const char *begin = p;
+    while (p != end && is_id_part(*p))
+        p++;
+    end_pos += static_cast<int>(p - begin);
+    const symbol sym = keyword(begin, p - begin);
+    if (sym != ID_ID)
+        return mk_token(sym);
+    return mk_token(ID_ID, std::string(begin, p));
+}
+
+token lexer::finish_number()
+{
+    const smt::I max = std::numeric_limits<smt::I>::max();
+    const char *begin = p;
+    smt::I num = 0;
+    while (p != end && *p >= '0' && *p <= '9')
     {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'o')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'i')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (ch != 'd')
-        {
-            is.unget();
-            return finish_id(str);
-        }
-        end_pos++;
-        str.push_back(ch);
-        ch = static_cast<char>(is.get());
-        if (!is_id_part(ch))
-        {
-            is.unget();
-            return mk_token(VOID_ID);
-        }
-        else
-        {
-            is.unget();
-            return finish_id(str);
-        }
+        if (num > (max - (*p - '0')) / 10)
+            error("numeric literal out of range..");
+        num = num * 10 + (*p++ - '0');
     }
-    case 'a':
-    case 'd':
-    case 'h':
-    case 'j':
-    case 'k':
-    case 'l':
-    case 'm':
-    case 'q':
-    case 'u':
-    case 'w':
-    case 'x':
-    case 'y':
-    case 'z':
-    case 'A':
-    case 'B':
-    case 'C':
-    case 'D':
-    case 'E':
-    case 'F':
-    case 'G':
-    case 'H':
-    case 'I':
-    case 'J':
-    case 'K':
-    case 'L':
-    case 'M':
-    case 'N':
-    case 'O':
-    case 'P':
-    case 'Q':
-    case 'R':
-    case 'S':
-    case 'T':
-    case 'U':
-    case 'V':
-    case 'W':
-    case 'X':
-    case 'Y':
-    case 'Z':
-    case '_':
+    if (p == end || *p != '.')
     {
-        end_pos++;
-        std::vector<char> str;
-        str.push_back(ch);
-        return finish_id(str);
+        end_pos += static_cast<int>(p - begin);
+        return mk_token(IntLiteral_ID, smt::rational(num));
     }
-    case '\t':
-        start_pos += 4 - (start_pos % 4);
-        end_pos += 4 - (end_pos % 4);
-        return finish_whitespaces();
-    case ' ':
-        start_pos++;
-        end_pos++;
-        return finish_whitespaces();
-    case '\r':
-        if (is.get() != '\n')
-            is.unget();
-    case '\n':
-        end_line++;
-        end_pos = 0;
-        return finish_whitespaces();
-    case EOF:
-        return mk_token(EOF_ID);
-    default:
-        error("invalid token..");
-        return nullptr;
-    }
-}
 
-token *lexer::finish_id(std::vector<char> &str)
-{
-    while (true)
+    p++; // the decimal part..
+    smt::I den = 1;
+    while (p != end && *p >= '0' && *p <= '9')
     {
-        ch = static_cast<char>(is.get());
-        if (str.empty() && ch >= '0' && ch <= '9')
-            error("identifiers cannot start with numbers..");
-        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_' || (ch >= '0' && ch <= '9'))
-        {
-            end_pos++;
-            str.push_back(ch);
-        }
-        else
-        {
-            is.unget();
-            return mk_id_token(std::string(str.begin(), str.end()));
-        }
+        if (num > (max - (*p - '0')) / 10 || den > max / 10)
+            error("numeric literal out of range..");
+        num = num * 10 + (*p++ - '0');
+        den *= 10;
     }
+    end_pos += static_cast<int>(p - begin);
+    if (p != end && *p == '.')
+        error("invalid numeric literal..");
+    return mk_token(RealLiteral_ID, smt::rational(num, den));
 }
 
-token *lexer::finish_whitespaces()
+token lexer::finish_string()
 {
+    p++; // the opening quote..
+    end_pos++;
+    std::string str;
     while (true)
     {
-        ch = static_cast<char>(is.get());
-        switch (ch)
+        if (p == end)
+            error("invalid string literal..");
+        switch (*p)
         {
-        case '\t':
-            start_pos += 4 - (start_pos % 4);
-            end_pos += 4 - (end_pos % 4);
-            break;
-        case ' ':
-            start_pos++;
+        case '"':
+            p++;
+            end_pos++;
+            return mk_token(StringLiteral_ID, str);
+        case '\\': // the escaped character is taken as is..
+            p++;
+            end_pos++;
+            if (p == end)
+                error("invalid string literal..");
+            str.push_back(*p++);
             end_pos++;
             break;
         case '\r':
-            if (is.get() != '\n')
-                is.unget();
         case '\n':
-            end_line++;
-            end_pos = 0;
-            break;
-        case EOF:
-            return mk_token(EOF_ID);
+            error("newline in string literal..");
         default:
-            is.unget();
-            return next();
+            str.push_back(*p++);
+            end_pos++;
         }
     }
 }
 
 void lexer::error(const std::string &err) { throw std::invalid_argument("[" + std::to_string(start_line) + ", " + std::to_string(start_pos) + "] " + err); }
-}
\ No newline at end of file
+}
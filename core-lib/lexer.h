@@ -1,7 +1,6 @@
 #pragma once
 
 #include "rational.h"
-#include <cmath>
 #include <istream>
 #include <vector>
 #include <string>
@@ -64,115 +63,45 @@ enum symbol
 class token
 {
 public:
-  token(const symbol &sym, const int &start_line, const int &start_pos, const int &end_line, const int &end_pos) : sym(sym), start_line(start_line), start_pos(start_pos), end_line(end_line), end_pos(end_pos) {}
-  virtual ~token() {}
+  token(const symbol &sym, const int &start_line, const int &start_pos, const int &end_line, const int &end_pos, const std::string &str = "", const smt::rational &val = smt::rational()) : sym(sym), start_line(start_line), start_pos(start_pos), end_line(end_line), end_pos(end_pos), str(str), val(val) {}
 
 public:
-  const symbol sym;
-  const int start_line;
-  const int start_pos;
-  const int end_line;
-  const int end_pos;
-};
-
-class id_token : public token
-{
-public:
-  id_token(const int &start_line, const int &start_pos, const int &end_line, const int &end_pos, const std::string &id) : token(ID_ID, start_line, start_pos, end_line, end_pos), id(id) {}
-  virtual ~id_token() {}
-
-public:
-  const std::string id;
-};
-
-class int_token : public token
-{
-public:
-  int_token(const int &start_line, const int &start_pos, const int &end_line, const int &end_pos, const smt::I &val) : token(IntLiteral_ID, start_line, start_pos, end_line, end_pos), val(val) {}
-  virtual ~int_token() {}
-
-public:
-  const smt::I val;
-};
-
-class real_token : public token
-{
-public:
-  real_token(const int &start_line, const int &start_pos, const int &end_line, const int &end_pos, const smt::rational &val) : token(RealLiteral_ID, start_line, start_pos, end_line, end_pos), val(val) {}
-  virtual ~real_token() {}
-
-public:
-  const smt::rational val;
-};
-
-class string_token : public token
-{
-public:
-  string_token(const int &start_line, const int &start_pos, const int &end_line, const int &end_pos, const std::string &str) : token(StringLiteral_ID, start_line, start_pos, end_line, end_pos), str(str) {}
-  virtual ~string_token() {}
-
-public:
-  const std::string str;
+  symbol sym;
+  int start_line;
+  int start_pos;
+  int end_line;
+  int end_pos;
+  std::string str;   // the name of the identifier or the content of the string literal..
+  smt::rational val; // the value of the numeric literal..
 };
 
 class lexer
 {
 public:
-  lexer(std::istream &is);
+  lexer(std::istream &is); // reads the whole stream at once and scans it from memory..
   lexer(const lexer &orig) = delete;
   virtual ~lexer();
 
-  token *next();
+  token next();
 
 private:
-  token *mk_token(const symbol &sym)
-  {
-    token *tk = new token(sym, start_line, start_pos, end_line, end_pos);
-    start_line = end_line;
-    start_pos = end_pos;
-    return tk;
-  }
-
-  token *mk_id_token(const std::string &id)
-  {
-    id_token *tk = new id_token(start_line, start_pos, end_line, end_pos, id);
-    start_line = end_line;
-    start_pos = end_pos;
-    return tk;
-  }
-
-  token *mk_integer_token(const std::string &str)
-  {
-    token *tk = new int_token(start_line, start_pos, end_line, end_pos, std::stol(str));
-    start_line = end_line;
-    start_pos = end_pos;
-    return tk;
-  }
-
-  token *mk_rational_token(const std::string &intgr, const std::string &dec)
-  {
-    token *tk = new real_token(start_line, start_pos, end_line, end_pos, smt::rational(std::stol(intgr + dec), static_cast<smt::I>(std::pow(10, dec.size()))));
-    start_line = end_line;
-    start_pos = end_pos;
-    return tk;
-  }
+  char peek(const size_t &i = 0) const { return p + i < end ? p[i] : '\0'; } // returns the i-th character after the current one, or '\0' if beyond the end of the buffer..
 
-  token *mk_string_token(const std::string &str)
-  {
-    string_token *tk = new string_token(start_line, start_pos, end_line, end_pos, str);
-    start_line = end_line;
-    start_pos = end_pos;
-    return tk;
-  }
+  token mk_token(const symbol &sym) { return token(sym, start_line, start_pos, end_line, end_pos); }
+  token mk_token(const symbol &sym, const std::string &str) { return token(sym, start_line, start_pos, end_line, end_pos, str); }
+  token mk_token(const symbol &sym, const smt::rational &val) { return token(sym, start_line, start_pos, end_line, end_pos, "", val); }
 
-  token *finish_id(std::vector<char> &str);
-  token *finish_whitespaces();
+  void skip_whitespaces(); // skips whitespaces and comments..
+  token finish_id();       // scans the rest of an identifier (or keyword)..
+  token finish_number();   // scans a numeric literal..
+  token finish_string();   // scans the rest of a string literal..
 
-  void error(const std::string &err);
+  [[noreturn]] void error(const std::string &err);
 
 private:
-  std::istream &is;
-  char ch;
+  std::string buf;         // the characters to be scanned..
+  const char *p = nullptr; // the current character..
+  const char *end = nullptr;
   int start_line = 0;
   int start_pos = 0;
   int end_line = 0;
@@ -1,9 +1,16 @@
 #include "parser.h"
+#include "ast_cache.h"
 #include "declaration.h"
 #include "statement.h"
 #include "expression.h"
 #include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include <string>
 #include <unordered_set>
 #include <stdexcept>
@@ -13,12 +20,18 @@ namespace lucy
 
 using namespace ast;
 
+std::string parser::cache_dir;
+std::atomic<size_t> parser::n_cache_hits(0);
+
 parser::parser() {}
 parser::~parser() {}
 
 compilation_unit *parser::parse(std::istream &is)
 {
-    lex = new lexer(is);
+    lexer lx(is);
+    lex = &lx;
+    tks.clear();
+    pos = 0;
     tk = next();
 
     std::vector<type_declaration *> ts;
@@ -81,17 +94,88 @@ compilation_unit *parser::parse(std::istream &is)
         }
     }
 
+    // the tokens are not needed anymore..
+    lex = nullptr;
+    tk = nullptr;
+    std::vector<token>().swap(tks);
+
     return new compilation_unit(ms, ps, ts, ss);
 }
 
-token *parser::next()
+std::vector<compilation_unit *> parser::parse_all(const std::vector<std::string> &files)
 {
-    while (pos >= tks.size())
+    std::vector<compilation_unit *> c_cus(files.size(), nullptr);
+    std::vector<std::exception_ptr> errs(files.size());
+    std::atomic<size_t> c_file(0); // the next file to be parsed..
+    const auto parse_files = [&]() {
+        parser prs;
+        for (size_t i = c_file++; i < files.size(); i = c_file++)
+            try
+            {
+                std::ifstream ifs(files[i], std::ios::binary);
+                if (!ifs)
+                    throw std::invalid_argument("file not found: " + files[i]);
+                std::stringstream src;
+                src << ifs.rdbuf();
+
+                if (cache_dir.empty())
+                    c_cus[i] = prs.parse(src);
+                else
+                {
+                    // the compiled form of the file, if any, is loaded in place of parsing it..
+                    const uint64_t src_hash = content_hash(src.str());
+                    const std::string cache_name = cache_file(cache_dir, src_hash);
+                    c_cus[i] = load_cache(cache_name, src_hash);
+                    if (c_cus[i])
+                        n_cache_hits++;
+                    else
+                    {
+                        c_cus[i] = prs.parse(src);
+                        store_cache(cache_name, src_hash, *c_cus[i]);
+                    }
+                }
+            }
+            catch (...)
+            {
+                errs[i] = std::current_exception();
+            }
+    };
+
+    const size_t n_threads = std::min<size_t>(files.size(), std::max(std::thread::hardware_concurrency(), 1u));
+    if (n_threads <= 1)
+        parse_files();
+    else
     {
-        token *c_tk = lex->next();
-        tks.push_back(c_tk);
+        std::vector<std::thread> ths;
+        for (size_t i = 0; i < n_threads; ++i)
+            ths.push_back(std::thread(parse_files));
+        for (auto &th : ths)
+            th.join();
     }
-    return tks[pos++];
+
+    // errors are reported in the same order of the files..
+    for (const auto &err : errs)
+        if (err)
+        {
+            for (const auto &cu : c_cus)
+                delete cu;
+            std::rethrow_exception(err);
+        }
+    return c_cus;
+}
+
+void parser::set_cache_dir(const std::string &dir)
+{
+    if (!dir.empty() && !cache_writable(dir))
+        throw std::invalid_argument("cannot write into the cache folder: " + dir);
+    cache_dir = dir;
+}
+
+const token *parser::next()
+{
+    while (pos >= tks.size())
+        tks.push_back(lex->next());
+    return &tks[pos++];
 }
 
 bool parser::match(const symbol &sym)
@@ -110,7 +194,7 @@ bool parser::match(const symbol &sym)
 void parser::backtrack(const size_t &p)
 {
     pos = p;
-    tk = tks[pos - 1];
+    tk = &tks[pos - 1];
 }
 
 typedef_declaration *parser::_typedef_declaration()
@@ -145,7 +229,7 @@ typedef_declaration *parser::_typedef_declaration()
 
     if (!match(ID_ID))
         error("expected identifier..");
-    n = static_cast<id_token *>(tks[pos - 2])->id;
+    n = tks[pos - 2].str;
 
     if (!match(SEMICOLON_ID))
         error("expected ';'..");
@@ -164,7 +248,7 @@ enum_declaration *parser::_enum_declaration()
 
     if (!match(ID_ID))
         error("expected identifier..");
-    n = static_cast<id_token *>(tks[pos - 2])->id;
+    n = tks[pos - 2].str;
 
     do
     {
@@ -174,13 +258,13 @@ enum_declaration *parser::_enum_declaration()
             tk = next();
             if (!match(StringLiteral_ID))
                 error("expected string literal..");
-            es.push_back(static_cast<string_token *>(tks[pos - 2])->str);
+            es.push_back(tks[pos - 2].str);
 
             while (match(COMMA_ID))
             {
                 if (!match(StringLiteral_ID))
                     error("expected string literal..");
-                es.push_back(static_cast<string_token *>(tks[pos - 2])->str);
+                es.push_back(tks[pos - 2].str);
             }
 
             if (!match(RBRACE_ID))
@@ -189,13 +273,13 @@ enum_declaration *parser::_enum_declaration()
         case ID_ID:
         {
             std::vector<std::string> ids;
-            ids.push_back(static_cast<id_token *>(tk)->id);
+            ids.push_back(tk->str);
             tk = next();
             while (match(DOT_ID))
             {
                 if (!match(ID_ID))
                     error("expected identifier..");
-                ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+                ids.push_back(tks[pos - 2].str);
             }
             trs.push_back(ids);
             break;
@@ -226,7 +310,7 @@ class_declaration *parser::_class_declaration()
 
     if (!match(ID_ID))
         error("expected identifier..");
-    n = static_cast<id_token *>(tks[pos - 2])->id;
+    n = tks[pos - 2].str;
 
     if (match(COLON_ID))
     {
@@ -237,7 +321,7 @@ class_declaration *parser::_class_declaration()
             {
                 if (!match(ID_ID))
                     error("expected identifier..");
-                ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+                ids.push_back(tks[pos - 2].str);
             } while (match(DOT_ID));
             bcs.push_back(ids);
         } while (match(COMMA_ID));
@@ -378,13 +462,13 @@ field_declaration *parser::_field_declaration()
         tk = next();
         break;
     case ID_ID:
-        ids.push_back(static_cast<id_token *>(tk)->id);
+        ids.push_back(tk->str);
         tk = next();
         while (match(DOT_ID))
         {
             if (!match(ID_ID))
                 error("expected identifier..");
-            ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+            ids.push_back(tks[pos - 2].str);
         }
         break;
     default:
@@ -393,7 +477,7 @@ field_declaration *parser::_field_declaration()
 
     if (!match(ID_ID))
         error("expected identifier..");
-    n = static_cast<id_token *>(tks[pos - 2])->id;
+    n = tks[pos - 2].str;
 
     if (match(EQ_ID))
         ds.push_back(new variable_declaration(n, _expression()));
@@ -404,7 +488,7 @@ field_declaration *parser::_field_declaration()
     {
         if (!match(ID_ID))
             error("expected identifier..");
-        n = static_cast<id_token *>(tks[pos - 2])->id;
+        n = tks[pos - 2].str;
 
         if (match(EQ_ID))
             ds.push_back(new variable_declaration(n, _expression()));
@@ -431,13 +515,13 @@ method_declaration *parser::_method_declaration()
         {
             if (!match(ID_ID))
                 error("expected identifier..");
-            ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+            ids.push_back(tks[pos - 2].str);
         } while (match(DOT_ID));
     }
 
     if (!match(ID_ID))
         error("expected identifier..");
-    n = static_cast<id_token *>(tks[pos - 2])->id;
+    n = tks[pos - 2].str;
 
     if (!match(LPAREN_ID))
         error("expected '('..");
@@ -466,13 +550,13 @@ method_declaration *parser::_method_declaration()
                 tk = next();
                 break;
             case ID_ID:
-                p_ids.push_back(static_cast<id_token *>(tk)->id);
+                p_ids.push_back(tk->str);
                 tk = next();
                 while (match(DOT_ID))
                 {
                     if (!match(ID_ID))
                         error("expected identifier..");
-                    p_ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+                    p_ids.push_back(tks[pos - 2].str);
                 }
                 break;
             default:
@@ -480,7 +564,7 @@ method_declaration *parser::_method_declaration()
             }
             if (!match(ID_ID))
                 error("expected identifier..");
-            std::string pn = static_cast<id_token *>(tks[pos - 2])->id;
+            std::string pn = tks[pos - 2].str;
             pars.push_back({p_ids, pn});
         } while (match(COMMA_ID));
 
@@ -517,13 +601,13 @@ constructor_declaration *parser::_constructor_declaration()
             switch (tk->sym)
             {
             case ID_ID:
-                p_ids.push_back(static_cast<id_token *>(tk)->id);
+                p_ids.push_back(tk->str);
                 tk = next();
                 while (match(DOT_ID))
                 {
                     if (!match(ID_ID))
                         error("expected identifier..");
-                    p_ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+                    p_ids.push_back(tks[pos - 2].str);
                 }
                 break;
             case BOOL_ID:
@@ -545,7 +629,7 @@ constructor_declaration *parser::_constructor_declaration()
             }
             if (!match(ID_ID))
                 error("expected identifier..");
-            std::string pn = static_cast<id_token *>(tks[pos - 2])->id;
+            std::string pn = tks[pos - 2].str;
             pars.push_back({p_ids, pn});
         } while (match(COMMA_ID));
 
@@ -561,7 +645,7 @@ constructor_declaration *parser::_constructor_declaration()
             std::vector<expression *> xprs;
             if (!match(ID_ID))
                 error("expected identifier..");
-            pn = static_cast<id_token *>(tks[pos - 2])->id;
+            pn = tks[pos - 2].str;
 
             if (!match(LPAREN_ID))
                 error("expected '('..");
@@ -601,7 +685,7 @@ predicate_declaration *parser::_predicate_declaration()
 
     if (!match(ID_ID))
         error("expected identifier..");
-    n = static_cast<id_token *>(tks[pos - 2])->id;
+    n = tks[pos - 2].str;
 
     if (!match(LPAREN_ID))
         error("expected '('..");
@@ -630,19 +714,19 @@ predicate_declaration *parser::_predicate_declaration()
                 tk = next();
                 break;
             case ID_ID:
-                p_ids.push_back(static_cast<id_token *>(tk)->id);
+                p_ids.push_back(tk->str);
                 tk = next();
                 while (match(DOT_ID))
                 {
                     if (!match(ID_ID))
                         error("expected identifier..");
-                    p_ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+                    p_ids.push_back(tks[pos - 2].str);
                 }
                 break;
             }
             if (!match(ID_ID))
                 error("expected identifier..");
-            std::string pn = static_cast<id_token *>(tks[pos - 2])->id;
+            std::string pn = tks[pos - 2].str;
             pars.push_back({p_ids, pn});
         } while (match(COMMA_ID));
 
@@ -659,7 +743,7 @@ predicate_declaration *parser::_predicate_declaration()
             {
                 if (!match(ID_ID))
                     error("expected identifier..");
-                p_ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+                p_ids.push_back(tks[pos - 2].str);
             } while (match(DOT_ID));
             pl.push_back(p_ids);
         } while (match(COMMA_ID));
@@ -703,7 +787,7 @@ statement *parser::_statement()
 
         if (!match(ID_ID))
             error("expected identifier..");
-        std::string n = static_cast<id_token *>(tks[pos - 2])->id;
+        std::string n = tks[pos - 2].str;
 
         expression *e = nullptr;
         if (tk->sym == EQ_ID)
@@ -721,20 +805,20 @@ statement *parser::_statement()
     {
         size_t c_pos = pos;
         std::vector<std::string> ids;
-        ids.push_back(static_cast<id_token *>(tk)->id);
+        ids.push_back(tk->str);
         tk = next();
         while (match(DOT_ID))
         {
             if (!match(ID_ID))
                 error("expected identifier..");
-            ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+            ids.push_back(tks[pos - 2].str);
         }
 
         switch (tk->sym)
         {
         case ID_ID: // a local field..
         {
-            std::string n = static_cast<id_token *>(tk)->id;
+            std::string n = tk->str;
             expression *e = nullptr;
             tk = next();
             if (tk->sym == EQ_ID)
@@ -841,7 +925,7 @@ statement *parser::_statement()
 
         if (!match(ID_ID))
             error("expected identifier..");
-        fn = static_cast<id_token *>(tks[pos - 2])->id;
+        fn = tks[pos - 2].str;
 
         if (!match(EQ_ID))
             error("expected '='..");
@@ -853,7 +937,7 @@ statement *parser::_statement()
         {
             if (!match(ID_ID))
                 error("expected identifier..");
-            scp.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+            scp.push_back(tks[pos - 2].str);
         } while (match(DOT_ID));
 
         pn = scp.back();
@@ -868,7 +952,7 @@ statement *parser::_statement()
             {
                 if (!match(ID_ID))
                     error("expected identifier..");
-                std::string assgn_name = static_cast<id_token *>(tks[pos - 2])->id;
+                std::string assgn_name = tks[pos - 2].str;
 
                 if (!match(COLON_ID))
                     error("expected ':'..");
@@ -910,19 +994,19 @@ expression *parser::_expression(const size_t &pr)
     case TRUE_ID:
     case FALSE_ID:
         tk = next();
-        e = new bool_literal_expression(tks[pos - 2]->sym == TRUE_ID);
+        e = new bool_literal_expression(tks[pos - 2].sym == TRUE_ID);
         break;
     case IntLiteral_ID:
         tk = next();
-        e = new int_literal_expression(static_cast<int_token *>(tks[pos - 2])->val);
+        e = new int_literal_expression(tks[pos - 2].val.numerator());
         break;
     case RealLiteral_ID:
         tk = next();
-        e = new real_literal_expression(static_cast<real_token *>(tks[pos - 2])->val);
+        e = new real_literal_expression(tks[pos - 2].val);
         break;
     case StringLiteral_ID:
         tk = next();
-        e = new string_literal_expression(static_cast<string_token *>(tks[pos - 2])->str);
+        e = new string_literal_expression(tks[pos - 2].str);
         break;
     case LPAREN_ID: // either a parenthesys expression or a cast..
     {
@@ -943,7 +1027,7 @@ expression *parser::_expression(const size_t &pr)
             {
                 if (!match(ID_ID))
                     error("expected identifier..");
-                ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+                ids.push_back(tks[pos - 2].str);
             } while (match(DOT_ID));
 
             if (!match(RPAREN_ID))
@@ -993,7 +1077,7 @@ expression *parser::_expression(const size_t &pr)
         {
             if (!match(ID_ID))
                 error("expected identifier..");
-            ids.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+            ids.push_back(tks[pos - 2].str);
         } while (match(DOT_ID));
 
         std::vector<expression *> xprs;
@@ -1017,13 +1101,13 @@ expression *parser::_expression(const size_t &pr)
     case ID_ID:
     {
         std::vector<std::string> is;
-        is.push_back(static_cast<id_token *>(tk)->id);
+        is.push_back(tk->str);
         tk = next();
         while (match(DOT_ID))
         {
             if (!match(ID_ID))
                 error("expected identifier..");
-            is.push_back(static_cast<id_token *>(tks[pos - 2])->id);
+            is.push_back(tks[pos - 2].str);
         }
         if (match(LPAREN_ID))
         {
@@ -2,6 +2,7 @@
 
 #include "lexer.h"
 #include <vector>
+#include <atomic>
 
 namespace lucy
 {
@@ -31,8 +32,12 @@ public:
 
   ast::compilation_unit *parse(std::istream &is);
 
+  static std::vector<ast::compilation_unit *> parse_all(const std::vector<std::string> &files); // parses the given files concurrently (one parser per file), returning the compilation units in the same order of the files (if a cache folder has been set, up to date caches of the files are loaded in place of parsing them, while missing ones are written)..
+  static void set_cache_dir(const std::string &dir);                                            // stores the compiled files into the given folder (an empty string, the default, disables the caches), throws an 'std::invalid_argument' if the folder cannot be written..
+  static size_t get_cache_hits() { return n_cache_hits; }                                       // returns the number of files which have been loaded from the cache folder, rather than parsed..
+
 private:
-  token *next();
+  const token *next();
   bool match(const symbol &sym);
   void backtrack(const size_t &p);
 
@@ -49,9 +54,12 @@ private:
   void error(const std::string &err);
 
 private:
-  lexer *lex = nullptr;     // the current lexer..
-  token *tk = nullptr;      // the current lookahead token..
-  std::vector<token *> tks; // all the tokens parsed so far..
-  size_t pos = 0;           // the current position within 0tks'..
+  lexer *lex = nullptr;      // the current lexer..
+  const token *tk = nullptr; // the current lookahead token (points into 'tks')..
+  std::vector<token> tks;    // all the tokens scanned so far..
+  size_t pos = 0;            // the current position within 'tks'..
+
+  static std::string cache_dir;             // the folder of the compiled files (caching is disabled if empty)..
+  static std::atomic<size_t> n_cache_hits; // the number of files loaded from the cache folder..
 };
 }
\ No newline at end of file
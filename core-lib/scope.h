@@ -2,6 +2,7 @@
 
 #include <map>
 #include <vector>
+#include <string>
 
 #define THIS_KEYWORD "this"
 #define RETURN_KEYWORD "return"
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+// the binary solution format, along with a reader which does not depend on the rest of the library (so that it can be used by consumers of the solutions)..
+// the file is meant to be mapped in memory: it is written in the native byte order and every table starts at an 8-byte aligned offset:
+//
+//     solution_header
+//     uint32_t predicates[n_predicates]     (the names of the predicates, as offsets into the string table, padded to 8 bytes)
+//     solution_atom atoms[n_atoms]          (in creation order)
+//     solution_value values[n_values]       (the first 'n_refs' values are the core's items, the others are the atoms' parameters)
+//     uint64_t enum_items[n_enum_items]     (the identifiers of the allowed items of the enumerative values)
+//     char strings[strings_size]            (null-terminated strings)
+//
+// the meaning of the numeric members of a value depends on its kind:
+//     BOOL_VALUE:   'num' is 1 if true, 0 if false, -1 if undefined..
+//     ARITH_VALUE:  the current value is 'num'/'den' + 'inf_num'/'inf_den' ε..
+//     OBJECT_VALUE: 'num' is the identifier of the item..
+//     STRING_VALUE: 'num' is the offset of the string into the string table..
+//     ENUM_VALUE:   'num' is the index of the first allowed item into the enum items table, 'den' is the number of allowed items (in creation order)..
+namespace lucy
+{
+
+const char SOLUTION_MAGIC[8] = {'L', 'U', 'C', 'Y', 'S', 'O', 'L', '\0'};
+const uint32_t SOLUTION_VERSION = 2;
+
+enum solution_atom_state
+{
+  ACTIVE_ATOM,   // the atom is active..
+  UNIFIED_ATOM,  // the atom is unified with another atom..
+  INACTIVE_ATOM  // the atom is not justified..
+};
+
+enum solution_value_kind
+{
+  BOOL_VALUE,   // a boolean value..
+  ARITH_VALUE,  // an arithmetic value..
+  OBJECT_VALUE, // an instance of a user defined type (or an atom)..
+  STRING_VALUE, // a string..
+  ENUM_VALUE    // an enumerative variable..
+};
+
+struct solution_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t n_predicates;
+  uint64_t n_atoms;
+  uint64_t n_refs;
+  uint64_t n_values;
+  uint64_t n_enum_items;
+  uint64_t strings_size;
+};
+
+struct solution_atom
+{
+  uint64_t id;          // the identifier of the atom..
+  uint32_t predicate;   // the index of the atom's predicate into the predicates table..
+  uint32_t state;       // a 'solution_atom_state'..
+  uint64_t first_value; // the index of the first parameter of the atom into the values table..
+  uint64_t n_values;    // the number of parameters of the atom..
+};
+
+struct solution_value
+{
+  uint32_t name; // the name of the value, as an offset into the string table..
+  uint32_t kind; // a 'solution_value_kind'..
+  int64_t num;
+  int64_t den;
+  int64_t inf_num;
+  int64_t inf_den;
+};
+
+// a read-only view of a binary solution held in memory (e.g., a mapped file), throws an 'std::invalid_argument' if the solution is malformed..
+// every table size, index and string offset is checked once, when the view is built, so that the accessors can be used without any further check..
+class solution_view
+{
+public:
+  solution_view(const char *const data, const size_t &size) : data(data)
+  {
+    if (size < sizeof(solution_header))
+      throw std::invalid_argument("invalid solution: truncated header");
+    const solution_header &h = header();
+    if (std::memcmp(h.magic, SOLUTION_MAGIC, sizeof(SOLUTION_MAGIC)) != 0)
+      throw std::invalid_argument("invalid solution: bad magic");
+    if (h.version != SOLUTION_VERSION)
+      throw std::invalid_argument("invalid solution: unsupported version");
+    preds_off = sizeof(solution_header);
+    atoms_off = table_end(preds_off, static_cast<uint64_t>(h.n_predicates) + h.n_predicates % 2, sizeof(uint32_t), size);
+    values_off = table_end(atoms_off, h.n_atoms, sizeof(solution_atom), size);
+    enums_off = table_end(values_off, h.n_values, sizeof(solution_value), size);
+    strings_off = table_end(enums_off, h.n_enum_items, sizeof(uint64_t), size);
+    if (h.n_refs > h.n_values || h.strings_size != size - strings_off || (h.strings_size && data[size - 1] != '\0'))
+      throw std::invalid_argument("invalid solution: bad sizes");
+
+    for (size_t i = 0; i < h.n_predicates; ++i)
+      if (reinterpret_cast<const uint32_t *>(data + preds_off)[i] >= h.strings_size)
+        throw std::invalid_argument("invalid solution: bad predicate name");
+    for (size_t i = 0; i < h.n_atoms; ++i)
+    {
+      const solution_atom &a = atom(i);
+      if (a.predicate >= h.n_predicates || a.state > INACTIVE_ATOM)
+        throw std::invalid_argument("invalid solution: bad atom");
+      if (a.first_value > h.n_values || a.n_values > h.n_values - a.first_value)
+        throw std::invalid_argument("invalid solution: bad atom parameters");
+    }
+    for (size_t i = 0; i < h.n_values; ++i)
+    {
+      const solution_value &v = values()[i];
+      if (v.name >= h.strings_size)
+        throw std::invalid_argument("invalid solution: bad value name");
+      switch (v.kind)
+      {
+      case BOOL_VALUE:
+      case OBJECT_VALUE:
+        break;
+      case ARITH_VALUE:
+        if (v.den <= 0 || v.inf_den <= 0)
+          throw std::invalid_argument("invalid solution: bad arithmetic value");
+        break;
+      case STRING_VALUE:
+        if (v.num < 0 || static_cast<uint64_t>(v.num) >= h.strings_size)
+          throw std::invalid_argument("invalid solution: bad string value");
+        break;
+      case ENUM_VALUE:
+        if (v.num < 0 || v.den < 0 || static_cast<uint64_t>(v.num) > h.n_enum_items || static_cast<uint64_t>(v.den) > h.n_enum_items - v.num)
+          throw std::invalid_argument("invalid solution: bad enumerative value");
+        break;
+      default:
+        throw std::invalid_argument("invalid solution: bad value kind");
+      }
+    }
+  }
+
+  const solution_header &header() const { return *reinterpret_cast<const solution_header *>(data); }
+
+  size_t n_predicates() const { return header().n_predicates; }
+  const char *predicate(const size_t &i) const { return string(reinterpret_cast<const uint32_t *>(data + preds_off)[i]); }
+
+  size_t n_atoms() const { return header().n_atoms; }
+  const solution_atom &atom(const size_t &i) const { return reinterpret_cast<const solution_atom *>(data + atoms_off)[i]; }
+  const solution_value *params(const solution_atom &a) const { return values() + a.first_value; }
+
+  size_t n_refs() const { return header().n_refs; }
+  const solution_value *refs() const { return values(); }
+
+  const uint64_t *allowed_items(const solution_value &v) const { return reinterpret_cast<const uint64_t *>(data + enums_off) + v.num; } // the identifiers of the allowed items of an enumerative value..
+
+  const char *string(const size_t &off) const { return data + strings_off + off; }
+
+private:
+  const solution_value *values() const { return reinterpret_cast<const solution_value *>(data + values_off); }
+
+  // the end of a table of 'n' elements, of 'elem_size' bytes each, starting at offset 'off' of a solution of 'size' bytes..
+  static size_t table_end(const size_t &off, const uint64_t &n, const size_t &elem_size, const size_t &size)
+  {
+    if (off > size || n > (size - off) / elem_size)
+      throw std::invalid_argument("invalid solution: bad sizes");
+    return off + n * elem_size;
+  }
+
+private:
+  const char *const data;
+  size_t preds_off;
+  size_t atoms_off;
+  size_t values_off;
+  size_t enums_off;
+  size_t strings_off;
+};
+}
@@ -0,0 +1,421 @@
+#include "solution_writer.h"
+#include "core.h"
+#include "predicate.h"
+#include "atom.h"
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <unordered_set>
+
+namespace lucy
+{
+
+solution_writer::solution_writer(const core &cr, std::ostream &os) : cr(cr), os(os) { buf.reserve(buf_size); }
+solution_writer::~solution_writer() {}
+
+void solution_writer::write()
+{
+    std::vector<item *> all_items;
+    std::vector<atom *> all_atoms;
+    collect(all_items, all_atoms);
+
+    put("{ ");
+    if (!all_items.empty())
+    {
+        put("\"items\" : [");
+        for (std::vector<item *>::const_iterator is_it = all_items.begin(); is_it != all_items.end(); ++is_it)
+        {
+            if (is_it != all_items.begin())
+                put(", ");
+            write_item(**is_it);
+        }
+        put(']');
+    }
+    if (!all_atoms.empty())
+    {
+        if (!all_items.empty())
+            put(", ");
+        put("\"atoms\" : [");
+        for (std::vector<atom *>::const_iterator as_it = all_atoms.begin(); as_it != all_atoms.end(); ++as_it)
+        {
+            if (as_it != all_atoms.begin())
+                put(", ");
+            write_atom(**as_it);
+        }
+        put(']');
+    }
+    if (!all_items.empty() || !all_atoms.empty())
+        put(", ");
+    put("\"refs\" : [");
+    write_items(cr.get_items());
+    put("] }");
+    flush();
+}
+
+void solution_writer::write_binary()
+{
+    std::vector<item *> all_items;
+    std::vector<atom *> all_atoms;
+    collect(all_items, all_atoms);
+
+    values.clear();
+    enum_items.clear();
+    strings.clear();
+    str_offs.clear();
+
+    // the core's items come first..
+    add_values(cr.get_items());
+    const size_t n_refs = values.size();
+
+    std::vector<uint32_t> preds;
+    std::unordered_map<const type *, uint32_t> pred_idx;
+    std::vector<solution_atom> atms;
+    atms.reserve(all_atoms.size());
+    for (const auto &a : all_atoms)
+    {
+        const auto at_pred = pred_idx.find(&a->tp);
+        uint32_t c_pred;
+        if (at_pred == pred_idx.end())
+        {
+            c_pred = static_cast<uint32_t>(preds.size());
+            preds.push_back(add_string(a->tp.name));
+            pred_idx.insert({&a->tp, c_pred});
+        }
+        else
+            c_pred = at_pred->second;
+
+        solution_atom sa;
+        sa.id = a->id;
+        sa.predicate = c_pred;
+        switch (cr.sat_cr.value(a->sigma))
+        {
+        case True:
+            sa.state = ACTIVE_ATOM;
+            break;
+        case False:
+            sa.state = UNIFIED_ATOM;
+            break;
+        default:
+            sa.state = INACTIVE_ATOM;
+        }
+        sa.first_value = values.size();
+        add_values(a->get_items());
+        sa.n_values = values.size() - sa.first_value;
+        atms.push_back(sa);
+    }
+    if (preds.size() % 2) // the atoms' table starts at an 8-byte aligned offset..
+        preds.push_back(0);
+
+    solution_header h;
+    std::memcpy(h.magic, SOLUTION_MAGIC, sizeof(SOLUTION_MAGIC));
+    h.version = SOLUTION_VERSION;
+    h.n_predicates = static_cast<uint32_t>(pred_idx.size());
+    h.n_atoms = atms.size();
+    h.n_refs = n_refs;
+    h.n_values = values.size();
+    h.n_enum_items = enum_items.size();
+    h.strings_size = strings.size();
+
+    os.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    os.write(reinterpret_cast<const char *>(preds.data()), preds.size() * sizeof(uint32_t));
+    os.write(reinterpret_cast<const char *>(atms.data()), atms.size() * sizeof(solution_atom));
+    os.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(solution_value));
+    os.write(reinterpret_cast<const char *>(enum_items.data()), enum_items.size() * sizeof(uint64_t));
+    os.write(strings.data(), strings.size());
+}
+
+void solution_writer::collect(std::vector<item *> &all_items, std::vector<atom *> &all_atoms) const
+{
+    // since types share their instances with their supertypes, items and atoms are collected once..
+    std::unordered_set<item *> seen;
+    for (const auto &p : cr.get_predicates())
+        for (const auto &a : p.second->get_instances())
+            if (seen.insert(&*a).second)
+                all_atoms.push_back(static_cast<atom *>(&*a));
+    std::queue<type *> q;
+    for (const auto &t : cr.get_types())
+        if (!t.second->primitive)
+            q.push(t.second);
+    while (!q.empty())
+    {
+        for (const auto &i : q.front()->get_instances())
+            if (seen.insert(&*i).second)
+                all_items.push_back(&*i);
+        for (const auto &p : q.front()->get_predicates())
+            for (const auto &a : p.second->get_instances())
+                if (seen.insert(&*a).second)
+                    all_atoms.push_back(static_cast<atom *>(&*a));
+        q.pop();
+    }
+    // ..and we sort them in creation order..
+    std::sort(all_items.begin(), all_items.end(), [](const item *i0, const item *i1) { return i0->id < i1->id; });
+    std::sort(all_atoms.begin(), all_atoms.end(), [](const atom *a0, const atom *a1) { return a0->id < a1->id; });
+}
+
+void solution_writer::write_item(const item &i)
+{
+    put("{ \"id\" : \"");
+    put(i.id);
+    put("\", \"type\" : \"");
+    put(i.tp.name);
+    put('"');
+    std::map<std::string, expr> is = i.get_items();
+    if (!is.empty())
+    {
+        put(", \"items\" : [ ");
+        write_items(is);
+        put(" ]");
+    }
+    put('}');
+}
+
+void solution_writer::write_atom(const atom &a)
+{
+    put("{ \"id\" : \"");
+    put(a.id);
+    put("\", \"predicate\" : \"");
+    put(a.tp.name);
+    put("\", \"state\" : ");
+    switch (cr.sat_cr.value(a.sigma))
+    {
+    case True:
+        put("\"Active\"");
+        break;
+    case False:
+        put("\"Unified\"");
+        break;
+    case Undefined:
+        put("\"Inactive\"");
+        break;
+    }
+    std::map<std::string, expr> is = a.get_items();
+    if (!is.empty())
+    {
+        put(", \"pars\" : [ ");
+        write_items(is);
+        put(" ]");
+    }
+    put('}');
+}
+
+void solution_writer::write_items(const std::map<std::string, expr> &items)
+{
+    for (std::map<std::string, expr>::const_iterator is_it = items.begin(); is_it != items.end(); ++is_it)
+    {
+        if (is_it != items.begin())
+            put(", ");
+        put("{ \"name\" : \"");
+        put(is_it->first);
+        put("\", \"type\" : \"");
+        put(is_it->second->tp.name);
+        put("\", \"value\" : ");
+        switch (is_it->second->kind)
+        {
+        case BOOL_ITEM:
+        {
+            const bool_item &bi = static_cast<const bool_item &>(*is_it->second);
+            put(bi.l.sign ? "{ \"lit\" : \"b" : "{ \"lit\" : \"!b");
+            put(bi.l.v);
+            put("\", \"val\" : ");
+            switch (cr.sat_cr.value(bi.l))
+            {
+            case True:
+                put("\"True\"");
+                break;
+            case False:
+                put("\"False\"");
+                break;
+            case Undefined:
+                put("\"Undefined\"");
+                break;
+            }
+            put(" }");
+            break;
+        }
+        case ARITH_ITEM:
+        {
+            const arith_item &ai = static_cast<const arith_item &>(*is_it->second);
+            put("{ \"lin\" : \"");
+            put(ai.l.to_string());
+            put("\", ");
+            write_value("val", cr.la_th.value(ai.l));
+            const auto lb = cr.la_th.lb(ai.l);
+            if (!lb.is_negative_infinite())
+            {
+                put(", ");
+                write_value("lb", lb);
+            }
+            const auto ub = cr.la_th.ub(ai.l);
+            if (!ub.is_positive_infinite())
+            {
+                put(", ");
+                write_value("ub", ub);
+            }
+            put(" }");
+            break;
+        }
+        case VAR_ITEM:
+        {
+            const var_item &ei = static_cast<const var_item &>(*is_it->second);
+            put("{ \"var\" : \"e");
+            put(ei.ev);
+            put("\", \"vals\" : [ ");
+            std::vector<const item *> vals;
+            for (const auto &val : cr.ov_th.value(ei.ev))
+                vals.push_back(static_cast<const item *>(val));
+            std::sort(vals.begin(), vals.end(), [](const item *i0, const item *i1) { return i0->id < i1->id; });
+            for (std::vector<const item *>::const_iterator vals_it = vals.begin(); vals_it != vals.end(); ++vals_it)
+            {
+                if (vals_it != vals.begin())
+                    put(", ");
+                put('"');
+                put((*vals_it)->id);
+                put('"');
+            }
+            put(" ] }");
+            break;
+        }
+        default:
+            put('"');
+            put(is_it->second->id);
+            put('"');
+        }
+        put(" }");
+    }
+}
+
+void solution_writer::write_value(const char *key, const smt::inf_rational &val)
+{
+    put('"');
+    put(key);
+    put("\" : { \"num\" : ");
+    put(val.get_rational().numerator());
+    put(", \"den\" : ");
+    put(val.get_rational().denominator());
+    if (val.get_infinitesimal() != rational::ZERO)
+    {
+        put(", \"inf\" : { \"num\" : ");
+        put(val.get_infinitesimal().numerator());
+        put(", \"den\" : ");
+        put(val.get_infinitesimal().denominator());
+        put(" }");
+    }
+    put(" }");
+}
+
+void solution_writer::add_values(const std::map<std::string, expr> &items)
+{
+    for (const auto &i : items)
+    {
+        solution_value v;
+        v.name = add_string(i.first);
+        v.num = 0;
+        v.den = 1;
+        v.inf_num = 0;
+        v.inf_den = 1;
+        switch (i.second->kind)
+        {
+        case BOOL_ITEM:
+            v.kind = BOOL_VALUE;
+            switch (cr.sat_cr.value(static_cast<const bool_item &>(*i.second).l))
+            {
+            case True:
+                v.num = 1;
+                break;
+            case False:
+                v.num = 0;
+                break;
+            case Undefined:
+                v.num = -1;
+                break;
+            }
+            break;
+        case ARITH_ITEM:
+        {
+            v.kind = ARITH_VALUE;
+            const auto val = cr.la_th.value(static_cast<const arith_item &>(*i.second).l);
+            v.num = val.get_rational().numerator();
+            v.den = val.get_rational().denominator();
+            v.inf_num = val.get_infinitesimal().numerator();
+            v.inf_den = val.get_infinitesimal().denominator();
+            break;
+        }
+        case STRING_ITEM:
+            v.kind = STRING_VALUE;
+            v.num = add_string(static_cast<string_item &>(*i.second).get_value());
+            break;
+        case VAR_ITEM:
+        {
+            v.kind = ENUM_VALUE;
+            v.num = enum_items.size();
+            for (const auto &val : cr.ov_th.value(static_cast<const var_item &>(*i.second).ev))
+                enum_items.push_back(static_cast<const item *>(val)->id);
+            std::sort(enum_items.begin() + v.num, enum_items.end());
+            v.den = enum_items.size() - v.num;
+            break;
+        }
+        default:
+            v.kind = OBJECT_VALUE;
+            v.num = i.second->id;
+        }
+        values.push_back(v);
+    }
+}
+
+uint32_t solution_writer::add_string(const std::string &str)
+{
+    const auto at_str = str_offs.find(str);
+    if (at_str != str_offs.end())
+        return at_str->second;
+    const uint32_t off = static_cast<uint32_t>(strings.size());
+    strings.append(str.c_str(), str.size() + 1);
+    str_offs.insert({str, off});
+    return off;
+}
+
+void solution_writer::put(const char *str)
+{
+    buf.append(str);
+    if (buf.size() >= buf_size)
+        flush();
+}
+
+void solution_writer::put(const std::string &str)
+{
+    buf.append(str);
+    if (buf.size() >= buf_size)
+        flush();
+}
+
+void solution_writer::put(const size_t &n)
+{
+    char digits[20];
+    char *p = digits + sizeof(digits);
+    size_t c_n = n;
+    do
+    {
+        *--p = static_cast<char>('0' + c_n % 10);
+        c_n /= 10;
+    } while (c_n);
+    buf.append(p, digits + sizeof(digits) - p);
+    if (buf.size() >= buf_size)
+        flush();
+}
+
+void solution_writer::put(const smt::I &n)
+{
+    if (n < 0)
+    {
+        put('-');
+        put(static_cast<size_t>(0) - static_cast<size_t>(n)); // avoids overflowing on the smallest integer..
+    }
+    else
+        put(static_cast<size_t>(n));
+}
+
+void solution_writer::flush()
+{
+    os.write(buf.data(), buf.size());
+    buf.clear();
+}
+}
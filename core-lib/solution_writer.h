@@ -0,0 +1,65 @@
+#pragma once
+
+#include "context.h"
+#include "inf_rational.h"
+#include "solution_format.h"
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lucy
+{
+
+class core;
+class item;
+class atom;
+
+// writes a description of the current solution directly into a stream, either as JSON (through a reusable buffer) or in the binary format of 'solution_format.h'..
+// items and atoms are written in creation order and are referred by their (sequential) identifiers, so that the same solution is always written in the same way..
+class solution_writer
+{
+public:
+  solution_writer(const core &cr, std::ostream &os);
+  solution_writer(const solution_writer &orig) = delete;
+  virtual ~solution_writer();
+
+  void write();        // writes the current solution as JSON..
+  void write_binary(); // writes the current solution in the binary format..
+
+private:
+  void collect(std::vector<item *> &all_items, std::vector<atom *> &all_atoms) const; // collects, in creation order, all the items and the atoms..
+
+  void write_item(const item &i);
+  void write_atom(const atom &a);
+  void write_items(const std::map<std::string, expr> &items);
+  void write_value(const char *key, const smt::inf_rational &val); // writes the given value, as a JSON member having the given key..
+
+  void add_values(const std::map<std::string, expr> &items); // appends the given items to the binary values table..
+  uint32_t add_string(const std::string &str);                // returns the offset of the given string into the binary string table..
+
+  void put(const char c)
+  {
+    buf.push_back(c);
+    if (buf.size() >= buf_size)
+      flush();
+  }
+  void put(const char *str);
+  void put(const std::string &str);
+  void put(const size_t &n);
+  void put(const smt::I &n);
+  void flush(); // moves the content of the buffer into the stream..
+
+private:
+  static const size_t buf_size = 1 << 16; // the size beyond which the buffer is flushed..
+  const core &cr;
+  std::ostream &os;
+  std::string buf; // the buffer, reused across flushes..
+
+  std::vector<solution_value> values;                   // the binary values table..
+  std::vector<uint64_t> enum_items;                     // the binary table of the allowed items of the enumerative values..
+  std::string strings;                                  // the binary string table..
+  std::unordered_map<std::string, uint32_t> str_offs; // the offsets of the strings into 'strings'..
+};
+}
@@ -1,4 +1,5 @@
 #include "statement.h"
+#include "ast_cache.h"
 #include "atom.h"
 #include "predicate.h"
 #include "core.h"
@@ -25,6 +26,14 @@ void assignment_statement::execute(const scope &scp, context &ctx) const
     c_e->items.insert({id, xpr->evaluate(scp, ctx)});
 }
 
+void assignment_statement::write(writer &w) const
+{
+    w.write_kind(ASSIGNMENT_STATEMENT);
+    w.write_ids(ids);
+    w.write_string(id);
+    w.write_expression(xpr);
+}
+
 local_field_statement::local_field_statement(const std::vector<std::string> &ft, const std::string &n, const expression *const e) : field_type(ft), name(n), xpr(e) {}
 local_field_statement::~local_field_statement() { delete xpr; }
 void local_field_statement::execute(const scope &scp, context &ctx) const
@@ -46,6 +55,14 @@ void local_field_statement::execute(const scope &scp, context &ctx) const
         const_cast<core *>(c)->fields.insert({name, new field(ctx->items.at(name)->tp, name)});
 }
 
+void local_field_statement::write(writer &w) const
+{
+    w.write_kind(LOCAL_FIELD_STATEMENT);
+    w.write_ids(field_type);
+    w.write_string(name);
+    w.write_expression(xpr);
+}
+
 expression_statement::expression_statement(const expression *const e) : xpr(e) {}
 expression_statement::~expression_statement() { delete xpr; }
 void expression_statement::execute(const scope &scp, context &ctx) const
@@ -57,6 +74,12 @@ void expression_statement::execute(const scope &scp, context &ctx) const
         throw inconsistency_exception();
 }
 
+void expression_statement::write(writer &w) const
+{
+    w.write_kind(EXPRESSION_STATEMENT);
+    w.write_expression(xpr);
+}
+
 block_statement::block_statement(const std::vector<const statement *> &stmnts) : statements(stmnts) {}
 block_statement::~block_statement()
 {
@@ -69,6 +92,12 @@ void block_statement::execute(const scope &scp, context &ctx) const
         st->execute(scp, ctx);
 }
 
+void block_statement::write(writer &w) const
+{
+    w.write_kind(BLOCK_STATEMENT);
+    w.write_all(statements);
+}
+
 disjunction_statement::disjunction_statement(const std::vector<std::pair<std::vector<const statement *>, const expression *const>> &conjs) : conjunctions(conjs) {}
 disjunction_statement::~disjunction_statement()
 {
@@ -96,6 +125,17 @@ void disjunction_statement::execute(const scope &scp, context &ctx) const
     scp.get_core().new_disjunction(ctx, *d);
 }
 
+void disjunction_statement::write(writer &w) const
+{
+    w.write_kind(DISJUNCTION_STATEMENT);
+    w.write_size(conjunctions.size());
+    for (const auto &conj : conjunctions)
+    {
+        w.write_all(conj.first);
+        w.write_expression(conj.second);
+    }
+}
+
 formula_statement::formula_statement(const bool &isf, const std::string &fn, const std::vector<std::string> &scp, const std::string &pn, const std::vector<std::pair<std::string, const expression *>> &assns) : is_fact(isf), formula_name(fn), formula_scope(scp), predicate_name(pn), assignments(assns) {}
 formula_statement::~formula_statement()
 {
@@ -197,8 +237,29 @@ void formula_statement::execute(const scope &scp, context &ctx) const
     ctx->items.insert({formula_name, expr(a)});
 }
 
+void formula_statement::write(writer &w) const
+{
+    w.write_kind(FORMULA_STATEMENT);
+    w.write_bool(is_fact);
+    w.write_string(formula_name);
+    w.write_ids(formula_scope);
+    w.write_string(predicate_name);
+    w.write_size(assignments.size());
+    for (const auto &asgnmnt : assignments)
+    {
+        w.write_string(asgnmnt.first);
+        w.write_expression(asgnmnt.second);
+    }
+}
+
 return_statement::return_statement(const expression *const e) : xpr(e) {}
 return_statement::~return_statement() { delete xpr; }
 void return_statement::execute(const scope &scp, context &ctx) const { ctx->items.insert({RETURN_KEYWORD, xpr->evaluate(scp, ctx)}); }
+
+void return_statement::write(writer &w) const
+{
+    w.write_kind(RETURN_STATEMENT);
+    w.write_expression(xpr);
+}
 }
 }
\ No newline at end of file
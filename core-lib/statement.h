@@ -13,6 +13,7 @@ namespace ast
 {
 
 class expression;
+class writer;
 
 class statement
 {
@@ -22,6 +23,7 @@ public:
   virtual ~statement();
 
   virtual void execute(const scope &scp, context &ctx) const = 0;
+  virtual void write(writer &w) const = 0; // writes the statement in binary form..
 };
 
 class assignment_statement : public statement
@@ -32,6 +34,7 @@ public:
   virtual ~assignment_statement();
 
   void execute(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::string> ids;
@@ -47,6 +50,7 @@ public:
   virtual ~local_field_statement();
 
   void execute(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::string> field_type;
@@ -62,6 +66,7 @@ public:
   virtual ~expression_statement();
 
   void execute(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const xpr;
@@ -75,6 +80,7 @@ public:
   virtual ~block_statement();
 
   void execute(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<const statement *> statements;
@@ -88,6 +94,7 @@ public:
   virtual ~disjunction_statement();
 
   void execute(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const std::vector<std::pair<std::vector<const statement *>, const expression *const>> conjunctions;
@@ -101,6 +108,7 @@ public:
   virtual ~formula_statement();
 
   void execute(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const bool is_fact;
@@ -118,6 +126,7 @@ public:
   virtual ~return_statement();
 
   void execute(const scope &scp, context &ctx) const override;
+  void write(writer &w) const override;
 
 private:
   const expression *const xpr;
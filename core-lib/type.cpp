@@ -12,7 +12,7 @@
 namespace lucy
 {
 
-type::type(core &cr, scope &scp, const std::string &name, bool primitive) : scope(cr, scp), name(name), primitive(primitive) {}
+type::type(core &cr, scope &scp, const std::string &name, bool primitive, bool smart) : scope(cr, scp), name(name), primitive(primitive), smart(smart) {}
 
 type::~type()
 {
@@ -34,7 +34,7 @@ class type : public scope
   friend class ast::predicate_declaration;
 
 public:
-  type(core &cr, scope &scp, const std::string &name, bool primitive = false);
+  type(core &cr, scope &scp, const std::string &name, bool primitive = false, bool smart = false);
   type(const type &orig) = delete;
   virtual ~type();
 
@@ -79,6 +79,7 @@ private:
 public:
   const std::string name;
   const bool primitive;
+  const bool smart; // whether the type checks its instances for inconsistencies (i.e., it can be statically cast to a 'cg::smart_type')..
 
 protected:
   std::vector<type *> supertypes;
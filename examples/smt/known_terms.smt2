@@ -0,0 +1,9 @@
+; the known terms of both the operands of a sum are kept..
+(set-logic QF_LRA)
+(declare-const x Real)
+(declare-const y Real)
+(assert (= x (+ 1 2)))
+(assert (= y (+ (+ x 1) (- x 2) 0.5)))
+(check-sat)
+(get-value (x y))
+(exit)
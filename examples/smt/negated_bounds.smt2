@@ -0,0 +1,18 @@
+; the negation of a non-strict bound is a strict bound: 'x > 1' and 'x < 1' leave no room for 'x = 1'..
+(set-logic QF_LRA)
+(declare-const x Real)
+(declare-const y Real)
+(push 1)
+(assert (not (<= x 1)))
+(assert (<= (+ x y) 2))
+(assert (>= y 1))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (>= x 1)))
+(assert (>= (+ x y) 2))
+(assert (<= y 1))
+(check-sat)
+(pop 1)
+(check-sat)
+(exit)
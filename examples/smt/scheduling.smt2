@@ -0,0 +1,34 @@
+; three activities sharing a unary resource: each activity lasts for some time and no two activities can overlap..
+(set-logic QF_LRA)
+(set-info :status sat)
+(declare-const s_a Real)
+(declare-const s_b Real)
+(declare-const s_c Real)
+(declare-const horizon Real)
+(define-fun e_a () Real (+ s_a 3))
+(define-fun e_b () Real (+ s_b 2.5))
+(define-fun e_c () Real (+ s_c (/ 3 2)))
+(assert (and (>= s_a 0) (>= s_b 0) (>= s_c 0)))
+(assert (or (<= e_a s_b) (<= e_b s_a)))
+(assert (or (<= e_a s_c) (<= e_c s_a)))
+(assert (or (<= e_b s_c) (<= e_c s_b)))
+(assert (and (<= e_a horizon) (<= e_b horizon) (<= e_c horizon)))
+(check-sat)
+(get-value (s_a s_b s_c horizon))
+; the activities cannot fit into a horizon shorter than their total duration..
+(push 1)
+(assert (< horizon 7))
+(check-sat)
+(pop 1)
+; ..while they can fit into a longer one, with 'a' strictly before 'b'..
+(push 1)
+(declare-const a_before_b Bool)
+(assert (= a_before_b (< e_a s_b)))
+(assert (<= horizon 7.5))
+(check-sat-assuming (a_before_b))
+(get-model)
+(check-sat-assuming ((not a_before_b) (= s_b 0) (= s_c 2.5)))
+(get-value (s_a s_b s_c horizon a_before_b))
+(pop 1)
+(check-sat)
+(exit)
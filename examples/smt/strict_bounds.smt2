@@ -0,0 +1,25 @@
+; a strict bound is tighter than the non-strict bound having the same value, even if the latter has been asserted first..
+(set-logic QF_LRA)
+(declare-const x Real)
+(declare-const y Real)
+(push 1)
+(assert (>= x 1))
+(assert (> x 1))
+(assert (<= (+ x y) 1))
+(assert (>= y 0))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (<= x 1))
+(assert (< x 1))
+(assert (>= (+ x y) 1))
+(assert (<= y 0))
+(check-sat)
+(pop 1)
+(assert (>= x 1))
+(assert (> x 1))
+(assert (<= x 2))
+(assert (< x 2))
+(check-sat)
+(get-value (x))
+(exit)
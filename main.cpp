@@ -1,4 +1,5 @@
 #include "solver.h"
+#include "parser.h"
 #ifdef BUILD_GUI
 #include "java_gui.h"
 #include "cg_java_listener.h"
@@ -8,9 +9,17 @@
 
 int main(int argc, char *argv[])
 {
+    // the '--binary' flag asks for a binary copy of the solution (see 'solution_format.h'), while the '--cache-dir <dir>' option stores the compiled input files into the given folder, so that later runs can skip parsing them..
+    bool binary = false;
+    std::string cache_dir;
     std::vector<std::string> prob_names;
     for (int i = 1; i < argc - 1; i++)
-        prob_names.push_back(argv[i]);
+        if (std::string(argv[i]) == "--binary")
+            binary = true;
+        else if (std::string(argv[i]) == "--cache-dir" && i + 1 < argc - 1)
+            cache_dir = argv[++i];
+        else
+            prob_names.push_back(argv[i]);
 
     std::string sol_name = argv[argc - 1];
 
@@ -21,6 +30,7 @@ int main(int argc, char *argv[])
         std::cout << " in debug mode";
 #endif
         std::cout << ".." << std::endl;
+        lucy::parser::set_cache_dir(cache_dir);
         cg::solver s;
 
 #ifdef BUILD_GUI
@@ -32,6 +42,8 @@ int main(int argc, char *argv[])
 
         std::cout << "parsing input files.." << std::endl;
         s.read(prob_names);
+        if (!cache_dir.empty())
+            std::cout << lucy::parser::get_cache_hits() << " files loaded from the cache.." << std::endl;
 
         std::cout << "solving the problem.." << std::endl;
         s.solve();
@@ -39,8 +51,23 @@ int main(int argc, char *argv[])
         std::cout << "hurray!! we have found a solution.." << std::endl;
         std::ofstream sol_file;
         sol_file.open(sol_name);
-        sol_file << s.to_string();
+        s.write(sol_file);
         sol_file.close();
+
+        // the statistics (and, if requested, the binary solution) are stored next to the solution..
+        std::string base_name = sol_name.size() > 5 && sol_name.compare(sol_name.size() - 5, 5, ".json") == 0 ? sol_name.substr(0, sol_name.size() - 5) : sol_name;
+        if (binary)
+        {
+            std::ofstream bin_file;
+            bin_file.open(base_name + ".sol", std::ios::binary);
+            s.write_binary(bin_file);
+            bin_file.close();
+        }
+
+        std::ofstream stats_file;
+        stats_file.open(base_name + ".stats.json");
+        stats_file << s.get_statistics();
+        stats_file.close();
     }
     catch (const std::exception &ex)
     {
@@ -0,0 +1,78 @@
+#include "dimacs.h"
+#include <sstream>
+
+namespace smt
+{
+
+dimacs_reader::dimacs_reader(sat_core &sat) : sat(sat) {}
+dimacs_reader::~dimacs_reader() {}
+
+bool dimacs_reader::read(std::istream &is)
+{
+    std::stringstream ss;
+    ss << is.rdbuf();
+    const std::string buf = ss.str();
+    const char *p = buf.c_str();
+    const char *const end = p + buf.size();
+
+    bool consistent = true;
+    size_t line = 1;
+    std::vector<lit> c_lits;
+    while (p < end)
+    {
+        switch (*p)
+        {
+        case '\n':
+            line++;
+            p++;
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+            p++;
+            break;
+        case 'c':
+        case 'p':
+            // comments and the problem line are skipped (variables are created as they are found)..
+            while (p < end && *p != '\n')
+                p++;
+            break;
+        case '%':
+            // some benchmark suites end the formula with a '%' line..
+            p = end;
+            break;
+        default:
+        {
+            bool negative = false;
+            if (*p == '-')
+            {
+                negative = true;
+                p++;
+            }
+            if (p == end || *p < '0' || *p > '9')
+                throw std::invalid_argument("[" + std::to_string(line) + "] expected a literal..");
+            size_t v = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+                v = v * 10 + (*p++ - '0');
+            if (v == 0)
+            {
+                // the end of the current clause..
+                clauses++;
+                if (consistent && !sat.new_clause(c_lits))
+                    consistent = false;
+                c_lits.clear();
+            }
+            else
+            {
+                while (vars.size() < v)
+                    vars.push_back(sat.new_var());
+                c_lits.push_back(lit(vars[v - 1], !negative));
+            }
+        }
+        }
+    }
+    if (!c_lits.empty())
+        throw std::invalid_argument("[" + std::to_string(line) + "] unterminated clause..");
+    return consistent;
+}
+}
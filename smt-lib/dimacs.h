@@ -0,0 +1,28 @@
+#pragma once
+
+#include "sat_core.h"
+#include <istream>
+
+namespace smt
+{
+
+// reads formulas in the DIMACS CNF format into a sat core (the 'p cnf' header is optional, comments and a SATLIB-style '%' terminator are skipped)..
+class dimacs_reader
+{
+public:
+  dimacs_reader(sat_core &sat);
+  dimacs_reader(const dimacs_reader &orig) = delete;
+  virtual ~dimacs_reader();
+
+  bool read(std::istream &is); // reads the clauses of the given stream, returns false if they are trivially unsatisfiable, throws an 'std::invalid_argument' if the input is malformed..
+
+  size_t n_vars() const { return vars.size(); }                   // the number of DIMACS variables read so far..
+  size_t n_clauses() const { return clauses; }                    // the number of clauses read so far..
+  var get_var(const size_t &i) const { return vars.at(i - 1); } // the sat variable of the given (1-based) DIMACS variable..
+
+private:
+  sat_core &sat;
+  std::vector<var> vars; // the sat variables of the DIMACS variables..
+  size_t clauses = 0;
+};
+}
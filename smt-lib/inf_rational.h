@@ -23,25 +23,25 @@ class inf_rational
     bool is_positive_infinite() const { return is_positive() && is_infinite(); }
     bool is_negative_infinite() const { return is_negative() && is_infinite(); }
 
-    bool operator!=(const inf_rational &rhs) const { return rat != rhs.rat && inf != rhs.inf; };
+    bool operator!=(const inf_rational &rhs) const { return rat != rhs.rat || inf != rhs.inf; };
     bool operator<(const inf_rational &rhs) const { return rat < rhs.rat || (rat == rhs.rat && inf < rhs.inf); };
-    bool operator<=(const inf_rational &rhs) const { return rat <= rhs.rat || (rat == rhs.rat && inf <= rhs.inf); };
+    bool operator<=(const inf_rational &rhs) const { return rat != rhs.rat ? rat <= rhs.rat : inf <= rhs.inf; };
     bool operator==(const inf_rational &rhs) const { return rat == rhs.rat && inf == rhs.inf; };
-    bool operator>=(const inf_rational &rhs) const { return rat >= rhs.rat || (rat == rhs.rat && inf >= rhs.inf); };
+    bool operator>=(const inf_rational &rhs) const { return rat != rhs.rat ? rat >= rhs.rat : inf >= rhs.inf; };
     bool operator>(const inf_rational &rhs) const { return rat > rhs.rat || (rat == rhs.rat && inf > rhs.inf); };
 
     bool operator!=(const rational &rhs) const { return rat != rhs || inf.numerator() != 0; };
     bool operator<(const rational &rhs) const { return rat < rhs || (rat == rhs && inf.numerator() < 0); };
-    bool operator<=(const rational &rhs) const { return rat <= rhs || (rat == rhs && inf.numerator() <= 0); };
+    bool operator<=(const rational &rhs) const { return rat != rhs ? rat <= rhs : inf.numerator() <= 0; };
     bool operator==(const rational &rhs) const { return rat == rhs && inf.numerator() == 0; };
-    bool operator>=(const rational &rhs) const { return rat >= rhs || (rat == rhs && inf.numerator() >= 0); };
+    bool operator>=(const rational &rhs) const { return rat != rhs ? rat >= rhs : inf.numerator() >= 0; };
     bool operator>(const rational &rhs) const { return rat > rhs || (rat == rhs && inf.numerator() > 0); };
 
     bool operator!=(const I &rhs) const { return rat != rhs || inf.numerator() != 0; };
     bool operator<(const I &rhs) const { return rat < rhs || (rat == rhs && inf.numerator() < 0); };
-    bool operator<=(const I &rhs) const { return rat <= rhs || (rat == rhs && inf.numerator() <= 0); };
+    bool operator<=(const I &rhs) const { return rat != rhs ? rat <= rhs : inf.numerator() <= 0; };
     bool operator==(const I &rhs) const { return rat == rhs && inf.numerator() == 0; };
-    bool operator>=(const I &rhs) const { return rat >= rhs || (rat == rhs && inf.numerator() >= 0); };
+    bool operator>=(const I &rhs) const { return rat != rhs ? rat >= rhs : inf.numerator() >= 0; };
     bool operator>(const I &rhs) const { return rat > rhs || (rat == rhs && inf.numerator() > 0); };
 
     inf_rational operator+(const inf_rational &rhs) const { return inf_rational(rat + rhs.rat, inf + rhs.inf); };
@@ -23,6 +23,19 @@ const var la_theory::new_var()
     return id;
 }
 
+void la_theory::reserve(const size_t &n)
+{
+    if (vals.capacity() >= vals.size() + n)
+        return;
+    // we still grow geometrically, so that many small reservations do not reallocate at each of them..
+    const size_t n_vars = std::max(vals.size() + n, 2 * vals.size());
+    assigns.reserve(2 * n_vars);
+    vals.reserve(n_vars);
+    exprs.reserve(exprs.size() + n_vars - vals.size());
+    a_watches.reserve(n_vars);
+    t_watches.reserve(n_vars);
+}
+
 const var la_theory::new_lt(const lin &left, const lin &right)
 {
     lin expr = left - right;
@@ -205,10 +218,10 @@ bool la_theory::propagate(const lit &p, std::vector<lit> &cnfl)
     const assertion *a = v_asrts.at(p.v);
     switch (a->o)
     {
-    case op::leq:
-        return p.sign ? assert_upper(a->x, a->v, p, cnfl) : assert_lower(a->x, a->v, p, cnfl);
-    case op::geq:
-        return p.sign ? assert_lower(a->x, a->v, p, cnfl) : assert_upper(a->x, a->v, p, cnfl);
+    case op::leq: // the negation of 'x <= v' is 'x > v' (i.e., 'x >= v + ε')..
+        return p.sign ? assert_upper(a->x, a->v, p, cnfl) : assert_lower(a->x, a->v + inf_rational(rational::ZERO, rational::ONE), p, cnfl);
+    case op::geq: // the negation of 'x >= v' is 'x < v' (i.e., 'x <= v - ε')..
+        return p.sign ? assert_lower(a->x, a->v, p, cnfl) : assert_upper(a->x, a->v - inf_rational(rational::ZERO, rational::ONE), p, cnfl);
     }
 
     return true;
@@ -217,6 +230,7 @@ bool la_theory::propagate(const lit &p, std::vector<lit> &cnfl)
 bool la_theory::check(std::vector<lit> &cnfl)
 {
     assert(cnfl.empty());
+    checks++;
     while (true)
     {
         const auto x_i_it = std::find_if(tableau.begin(), tableau.end(), [&](const std::pair<var, row *> &v) { return value(v.first) < lb(v.first) || value(v.first) > ub(v.first); });
@@ -290,6 +304,7 @@ bool la_theory::assert_lower(const var &x_i, const inf_rational &val, const lit
         if (!layers.empty() && layers.back().find(lb_index(x_i)) == layers.back().end())
             layers.back().insert({lb_index(x_i), {lb(x_i), assigns.at(lb_index(x_i)).reason}});
         assigns[lb_index(x_i)] = {val, new lit(p.v, p.sign)};
+        bound_updates++;
 
         if (vals.at(x_i) < val && tableau.find(x_i) == tableau.end())
             update(x_i, val);
@@ -323,6 +338,7 @@ bool la_theory::assert_upper(const var &x_i, const inf_rational &val, const lit
         if (!layers.empty() && layers.back().find(ub_index(x_i)) == layers.back().end())
             layers.back().insert({ub_index(x_i), {ub(x_i), assigns.at(ub_index(x_i)).reason}});
         assigns[ub_index(x_i)] = {val, new lit(p.v, p.sign)};
+        bound_updates++;
 
         if (vals.at(x_i) > val && tableau.find(x_i) == tableau.end())
             update(x_i, val);
@@ -399,6 +415,7 @@ void la_theory::pivot_and_update(const var &x_i, const var &x_j, const inf_ratio
 
 void la_theory::pivot(const var x_i, const var x_j)
 {
+    pivots++;
     // the exiting row..
     row *ex_row = tableau.at(x_i);
     lin expr = std::move(ex_row->l);
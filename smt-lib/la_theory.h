@@ -25,6 +25,7 @@ public:
   virtual ~la_theory();
 
   const var new_var();
+  void reserve(const size_t &n); // reserves the room for 'n' more variables, so that creating them in bulk does not reallocate the per-variable structures..
 
   const var new_lt(const lin &left, const lin &right);
   const var new_leq(const lin &left, const lin &right);
@@ -35,6 +36,11 @@ public:
   inf_rational ub(const var &v) const { return assigns[ub_index(v)].value; } // the current upper bound of variable 'v'..
   inf_rational value(const var &v) const { return vals[v]; }                 // the current value of variable 'v'..
 
+  size_t n_vars() const { return vals.size(); }            // the number of variables (including the slack ones)..
+  size_t n_pivots() const { return pivots; }               // the number of pivoting operations performed so far..
+  size_t n_bound_updates() const { return bound_updates; } // the number of tightened bounds so far..
+  size_t n_checks() const { return checks; }               // the number of consistency checks performed so far..
+
   inf_rational lb(const lin &l) const // the current lower bound of linear expression 'l'..
   {
     inf_rational b(l.known_term);
@@ -97,6 +103,9 @@ private:
   std::vector<std::set<row *>> t_watches;                // for each variable 'v', a list of tableau rows watching 'v'..
   std::vector<std::unordered_map<size_t, bound>> layers; // we store the updated bounds..
   std::unordered_map<var, std::list<la_value_listener *>> listening;
+  size_t pivots = 0;        // the number of pivoting operations..
+  size_t bound_updates = 0; // the number of tightened bounds..
+  size_t checks = 0;        // the number of consistency checks..
 };
 
 class la_value_listener
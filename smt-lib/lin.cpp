@@ -21,7 +21,7 @@ lin lin::operator+(const lin &right) const
             it = res.vars.erase(it);
         else
             ++it;
-    res.known_term += known_term;
+    res.known_term += right.known_term;
     return res;
 }
 
@@ -118,7 +118,7 @@ lin lin::operator+=(const lin &right)
 lin lin::operator+=(const std::pair<var, rational> &term)
 {
     if (vars.find(term.first) == vars.end())
-        vars.insert({term.first, -term.second});
+        vars.insert(term);
     else
         vars[term.first] += term.second;
 
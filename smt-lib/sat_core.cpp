@@ -31,12 +31,23 @@ const var sat_core::new_var()
     watches.push_back(std::vector<clause *>());
     watches.push_back(std::vector<clause *>());
     assigns.push_back(Undefined);
-    exprs.insert({"b" + std::to_string(id), id});
     level.push_back(0);
     reason.push_back(nullptr);
     return id;
 }
 
+void sat_core::reserve(const size_t &n)
+{
+    if (assigns.capacity() >= assigns.size() + n)
+        return;
+    // we still grow geometrically, so that many small reservations do not reallocate at each of them..
+    const size_t n_vars = std::max(assigns.size() + n, 2 * assigns.size());
+    watches.reserve(2 * n_vars);
+    assigns.reserve(n_vars);
+    level.reserve(n_vars);
+    reason.reserve(n_vars);
+}
+
 bool sat_core::new_clause(const std::vector<lit> &lits)
 {
     assert(root_level());
@@ -107,6 +118,8 @@ const var sat_core::new_conj(const std::vector<lit> &ls)
     assert(root_level());
     std::vector<lit> c_lits = ls;
     std::sort(c_lits.begin(), c_lits.end(), [](const lit &l0, const lit &l1) { return l0.v > l1.v; });
+    if (c_lits.size() == 1 && c_lits[0].sign) // the expression is the variable itself..
+        return c_lits[0].v;
     std::string s_expr;
     for (std::vector<lit>::const_iterator it = c_lits.begin(); it != c_lits.end(); ++it)
     {
@@ -141,6 +154,8 @@ const var sat_core::new_disj(const std::vector<lit> &ls)
 {
     std::vector<lit> c_lits = ls;
     std::sort(c_lits.begin(), c_lits.end(), [](const lit &l0, const lit &l1) { return l0.v > l1.v; });
+    if (c_lits.size() == 1 && c_lits[0].sign) // the expression is the variable itself..
+        return c_lits[0].v;
     std::string s_expr;
     for (std::vector<lit>::const_iterator it = c_lits.begin(); it != c_lits.end(); ++it)
     {
@@ -175,6 +190,8 @@ const var sat_core::new_exct_one(const std::vector<lit> &ls)
 {
     std::vector<lit> c_lits = ls;
     std::sort(c_lits.begin(), c_lits.end(), [](const lit &l0, const lit &l1) { return l0.v > l1.v; });
+    if (c_lits.size() == 1 && c_lits[0].sign) // the expression is the variable itself..
+        return c_lits[0].v;
     std::string s_expr;
     for (std::vector<lit>::const_iterator it = c_lits.begin(); it != c_lits.end(); ++it)
     {
@@ -210,6 +227,7 @@ const var sat_core::new_exct_one(const std::vector<lit> &ls)
 
 bool sat_core::assume(const lit &p)
 {
+    decisions++;
     trail_lim.push_back(trail.size());
     for (const auto &th : theories)
         th->push();
@@ -235,6 +253,8 @@ bool sat_core::check()
         {
             if (root_level())
                 return false;
+            if (interrupt && interrupt())
+                throw interrupted_exception();
             std::vector<lit> no_good;
             size_t bt_level;
             // we analyze the conflict..
@@ -252,21 +272,24 @@ bool sat_core::check()
 
 bool sat_core::check(const std::vector<lit> &lits)
 {
+    probes++;
+    // the decisions and the conflicts of the probe are not counted among those of the search..
+    const size_t c_decisions = decisions, c_conflicts = conflicts;
     size_t c_level = decision_level();
     std::vector<lit> cnfl;
+    bool consistent = true;
     for (const auto &p : lits)
-    {
         // notice that these literals can be modified by propagation..
         if (!assume(p) || !propagate(cnfl))
         {
-            while (decision_level() > c_level)
-                pop();
-            return false;
+            consistent = false;
+            break;
         }
-    }
     while (decision_level() > c_level)
         pop();
-    return true;
+    decisions = c_decisions;
+    conflicts = c_conflicts;
+    return consistent;
 }
 
 bool sat_core::propagate(std::vector<lit> &cnfl)
@@ -280,6 +303,7 @@ bool sat_core::propagate(std::vector<lit> &cnfl)
             if (!tmp.at(i)->propagate(prop_q.front()))
             {
                 // constraint is conflicting..
+                conflicts++;
                 for (size_t j = i + 1; j < tmp.size(); j++)
                     watches[index(prop_q.front())].push_back(tmp[j]);
                 assert(std::count_if(tmp.at(i)->lits.begin(), tmp.at(i)->lits.end(), [&](const lit &p) { return std::find(watches.at(index(!p)).begin(), watches.at(index(!p)).end(), tmp[i]) != watches.at(index(!p)).end(); }) == 2);
@@ -296,12 +320,14 @@ bool sat_core::propagate(std::vector<lit> &cnfl)
             if (!th->propagate(prop_q.front(), cnfl))
             {
                 assert(!cnfl.empty());
+                conflicts++;
                 while (!prop_q.empty())
                     prop_q.pop();
                 return false;
             }
 
         prop_q.pop();
+        propagations++;
     }
 
     // we check theories..
@@ -309,6 +335,7 @@ bool sat_core::propagate(std::vector<lit> &cnfl)
         if (!th->check(cnfl))
         {
             assert(!cnfl.empty());
+            conflicts++;
             return false;
         }
 
@@ -365,6 +392,7 @@ void sat_core::analyze(const std::vector<lit> &cnfl, std::vector<lit> &out_learn
 
 void sat_core::record(const std::vector<lit> &lits)
 {
+    learnts++;
     assert(value(lits[0]) == Undefined);
     assert(std::count_if(lits.begin(), lits.end(), [&](const lit &p) { return value(p) == True; }) == 0);
     assert(std::count_if(lits.begin(), lits.end(), [&](const lit &p) { return value(p) == Undefined; }) == 1);
@@ -5,6 +5,8 @@
 #include <queue>
 #include <unordered_map>
 #include <list>
+#include <functional>
+#include <stdexcept>
 
 namespace smt
 {
@@ -23,6 +25,14 @@ enum lbool
     Undefined
 };
 
+class interrupted_exception : public std::runtime_error
+{
+
+  public:
+    interrupted_exception() : runtime_error("the search has been interrupted") {}
+    interrupted_exception(const std::string &what_arg) : runtime_error(what_arg) {}
+};
+
 class sat_core
 {
     friend class clause;
@@ -35,6 +45,7 @@ class sat_core
     virtual ~sat_core();
 
     const var new_var();
+    void reserve(const size_t &n); // reserves the room for 'n' more variables, so that creating them in bulk does not reallocate the per-variable structures..
     bool new_clause(const std::vector<lit> &lits);
 
     const var new_eq(const lit &left, const lit &right);
@@ -62,9 +73,14 @@ class sat_core
     bool assume(const lit &p);
     void pop();
 
-    size_t n_vars() { return assigns.size(); }             // the number of variables..
-    size_t n_assigns() { return trail.size(); }            // the number of assigned variables..
-    size_t n_constrs() { return constrs.size(); }          // the number of constraints..
+    size_t n_vars() const { return assigns.size(); }       // the number of variables..
+    size_t n_assigns() const { return trail.size(); }      // the number of assigned variables..
+    size_t n_constrs() const { return constrs.size(); }    // the number of constraints..
+    size_t n_decisions() const { return decisions; }       // the number of decisions (i.e., assumed literals) taken so far..
+    size_t n_propagations() const { return propagations; } // the number of propagated literals so far..
+    size_t n_conflicts() const { return conflicts; }       // the number of conflicts found so far..
+    size_t n_learnts() const { return learnts; }           // the number of learnt clauses (including theory explanations) so far..
+    size_t n_probes() const { return probes; }             // the number of checks of a set of literals (i.e., calls to 'check(lits)'), whose decisions and conflicts are not counted among the above ones..
     lbool value(const var &x) const { return assigns[x]; } // returns the value of variable 'v'..
 
     lbool value(const lit &p) const
@@ -90,6 +106,8 @@ class sat_core
     bool check();
     bool check(const std::vector<lit> &lits);
 
+    void set_interrupt(const std::function<bool()> &intr) { interrupt = intr; } // sets a function which is polled at each conflict: if it returns true, 'check' throws an 'interrupted_exception', leaving the conflicting assignment to be popped..
+
   private:
     bool propagate(std::vector<lit> &cnfl);
     void analyze(const std::vector<lit> &cnfl, std::vector<lit> &out_learnt, size_t &out_btlevel);
@@ -122,6 +140,12 @@ class sat_core
     std::vector<theory *> theories; // all the theories..
     std::unordered_map<var, std::list<theory *>> bounds;
     std::unordered_map<var, std::list<sat_value_listener *>> listening;
+    std::function<bool()> interrupt; // whether the search should be interrupted..
+    size_t decisions = 0;             // the number of decisions..
+    size_t propagations = 0;          // the number of propagated literals..
+    size_t conflicts = 0;             // the number of conflicts..
+    size_t learnts = 0;               // the number of learnt clauses..
+    size_t probes = 0;                // the number of checks of a set of literals..
 };
 
 class sat_value_listener
@@ -0,0 +1,58 @@
+#include "sat_search.h"
+
+namespace smt
+{
+
+sat_search::sat_search(sat_core &sat) : sat(sat) {}
+sat_search::~sat_search() {}
+
+bool sat_search::solve(const std::vector<lit> &assumptions)
+{
+    reset();
+    if (!consistent || !sat.check())
+        return consistent = false;
+    var next = 0;
+    while (true)
+    {
+        const size_t c_level = sat.decision_level();
+        // since the assumptions are assumed before any other decision, a backjump either keeps them or unassigns them..
+        lit dec;
+        bool found = false;
+        for (const auto &p : assumptions)
+        {
+            const lbool val = sat.value(p);
+            if (val == False)
+            {
+                // the assumptions are inconsistent with the constraints..
+                reset();
+                return false;
+            }
+            else if (val == Undefined)
+            {
+                dec = p;
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            while (next < sat.n_vars() && sat.value(next) != Undefined)
+                next++;
+            if (next == sat.n_vars())
+                return true;
+            dec = lit(next, false);
+        }
+        sat.assume(dec);
+        if (!sat.check())
+            return consistent = false;
+        if (sat.decision_level() <= c_level) // we have backjumped, hence some of the previous variables might have been unassigned..
+            next = 0;
+    }
+}
+
+void sat_search::reset()
+{
+    while (!sat.root_level())
+        sat.pop();
+}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "sat_core.h"
+
+namespace smt
+{
+
+// a simple decision procedure for using a sat core (along with its theories) as a standalone solver: the assumptions are assumed first, then the first unassigned variable is assigned to false until either all the variables are assigned or a conflict is found..
+// propagation, conflict analysis and backjumping are left to the sat core..
+class sat_search
+{
+public:
+  sat_search(sat_core &sat);
+  sat_search(const sat_search &orig) = delete;
+  virtual ~sat_search();
+
+  bool solve(const std::vector<lit> &assumptions = {}); // searches for an assignment satisfying both the constraints and the given assumptions, which is left into the core (until 'reset' is called)..
+  void reset();                                         // backtracks the core to root level..
+
+private:
+  sat_core &sat;
+  bool consistent = true; // false once a conflict has been found at root level (the constraints are, hence, unsatisfiable)..
+};
+}
@@ -0,0 +1,564 @@
+#include "smtlib_reader.h"
+#include <algorithm>
+#include <cctype>
+
+namespace smt
+{
+
+struct sexpr
+{
+    bool list = false;
+    std::string atom;       // the symbol, keyword, numeral or string of an atom (strings keep their quotes)..
+    std::vector<sexpr> es;  // the elements of a list..
+    size_t line = 0;        // the line where the s-expression starts..
+};
+
+static std::invalid_argument error(const size_t &line, const std::string &msg) { return std::invalid_argument("[" + std::to_string(line) + "] " + msg); }
+
+// returns the given symbol, quoted if it is not a simple symbol..
+static std::string quote(const std::string &sym)
+{
+    if (!sym.empty() && !std::isdigit(sym.front()) && std::all_of(sym.begin(), sym.end(), [](const char &c) { return std::isalnum(c) || std::string("~!@$%^&*_-+=<>.?/").find(c) != std::string::npos; }))
+        return sym;
+    return "|" + sym + "|";
+}
+
+smtlib_reader::smtlib_reader(sat_core &sat, la_theory &la, std::ostream &os) : sat(sat), la(la), search(sat), os(os) {}
+smtlib_reader::~smtlib_reader() {}
+
+bool smtlib_reader::read(std::istream &is)
+{
+    sexpr cmd;
+    while (next(is, cmd))
+        if (!execute(cmd))
+            return false;
+    return true;
+}
+
+bool smtlib_reader::next(std::istream &is, sexpr &e)
+{
+    std::streambuf &sb = *is.rdbuf();
+    // we skip whitespaces and comments..
+    while (true)
+    {
+        const int c = sb.sgetc();
+        if (c == std::char_traits<char>::eof())
+            return false;
+        else if (c == '\n')
+            line++;
+        else if (c == ';')
+        {
+            while (sb.sgetc() != std::char_traits<char>::eof() && sb.sgetc() != '\n')
+                sb.sbumpc();
+            continue;
+        }
+        else if (!std::isspace(c))
+            break;
+        sb.sbumpc();
+    }
+
+    e.line = line;
+    e.atom.clear();
+    e.es.clear();
+    const int c = sb.sbumpc();
+    switch (c)
+    {
+    case '(':
+    {
+        e.list = true;
+        while (true)
+        {
+            // we look for the closing parenthesis..
+            int c_c = sb.sgetc();
+            while (c_c != std::char_traits<char>::eof() && (std::isspace(c_c) || c_c == ';'))
+            {
+                if (c_c == ';')
+                    while (sb.sgetc() != std::char_traits<char>::eof() && sb.sgetc() != '\n')
+                        sb.sbumpc();
+                else
+                {
+                    if (c_c == '\n')
+                        line++;
+                    sb.sbumpc();
+                }
+                c_c = sb.sgetc();
+            }
+            if (c_c == ')')
+            {
+                sb.sbumpc();
+                return true;
+            }
+            e.es.push_back(sexpr());
+            if (!next(is, e.es.back()))
+                throw error(e.line, "missing ')'..");
+        }
+    }
+    case ')':
+        throw error(line, "unexpected ')'..");
+    case '|':
+        // a quoted symbol..
+        e.list = false;
+        while (sb.sgetc() != '|')
+        {
+            if (sb.sgetc() == std::char_traits<char>::eof())
+                throw error(e.line, "missing '|'..");
+            if (sb.sgetc() == '\n')
+                line++;
+            e.atom.push_back(static_cast<char>(sb.sbumpc()));
+        }
+        sb.sbumpc();
+        return true;
+    case '"':
+        // a string literal, in which '""' stands for a quote..
+        e.list = false;
+        e.atom.push_back('"');
+        while (true)
+        {
+            const int c_c = sb.sbumpc();
+            if (c_c == std::char_traits<char>::eof())
+                throw error(e.line, "missing '\"'..");
+            if (c_c == '\n')
+                line++;
+            if (c_c == '"')
+            {
+                if (sb.sgetc() != '"')
+                    break;
+                sb.sbumpc();
+            }
+            e.atom.push_back(static_cast<char>(c_c));
+        }
+        e.atom.push_back('"');
+        return true;
+    default:
+        e.list = false;
+        e.atom.push_back(static_cast<char>(c));
+        while (sb.sgetc() != std::char_traits<char>::eof() && !std::isspace(sb.sgetc()) && sb.sgetc() != '(' && sb.sgetc() != ')' && sb.sgetc() != ';' && sb.sgetc() != '"' && sb.sgetc() != '|')
+            e.atom.push_back(static_cast<char>(sb.sbumpc()));
+        return true;
+    }
+}
+
+bool smtlib_reader::execute(const sexpr &cmd)
+{
+    if (!cmd.list || cmd.es.empty() || cmd.es[0].list)
+        throw error(cmd.line, "expected a command..");
+    const std::string &name = cmd.es[0].atom;
+    if (name == "exit")
+        return false;
+    else if (name == "set-logic")
+    {
+        if (cmd.es.size() != 2 || (cmd.es[1].atom != "QF_LRA" && cmd.es[1].atom != "QF_RDL"))
+            throw error(cmd.line, "unsupported logic..");
+    }
+    else if (name == "set-info" || name == "set-option")
+        ; // all the options and the information are ignored..
+    else if (name == "declare-const" || name == "declare-fun")
+    {
+        const bool fun = name == "declare-fun";
+        if (cmd.es.size() != (fun ? 4 : 3) || cmd.es[1].list || (fun && (!cmd.es[2].list || !cmd.es[2].es.empty())))
+            throw error(cmd.line, fun ? "expected '(declare-fun <symbol> () <sort>)', uninterpreted functions are not supported.." : "expected '(declare-const <symbol> <sort>)'..");
+        backtrack();
+        const std::string &sort = cmd.es.back().atom;
+        term t;
+        if (sort == "Bool")
+        {
+            t.real = false;
+            t.l = sat.new_var();
+        }
+        else if (sort == "Real")
+        {
+            t.real = true;
+            t.ln = lin(la.new_var(), rational::ONE);
+        }
+        else
+            throw error(cmd.es.back().line, "unsupported sort..");
+        new_symbol(cmd.es[1], t, true);
+    }
+    else if (name == "define-fun")
+    {
+        if (cmd.es.size() != 5 || cmd.es[1].list || !cmd.es[2].list || !cmd.es[2].es.empty())
+            throw error(cmd.line, "expected '(define-fun <symbol> () <sort> <term>)'..");
+        backtrack();
+        const term t = to_term(cmd.es[4]);
+        if (cmd.es[3].atom != (t.real ? "Real" : "Bool"))
+            throw error(cmd.es[3].line, "sort mismatch..");
+        new_symbol(cmd.es[1], t, false);
+    }
+    else if (name == "assert")
+    {
+        if (cmd.es.size() != 2)
+            throw error(cmd.line, "expected '(assert <term>)'..");
+        backtrack();
+        const lit l = to_lit(cmd.es[1]);
+        if (levels.empty())
+        {
+            if (!sat.new_clause({l}))
+                consistent = false;
+        }
+        else if (!sat.new_clause({lit(levels.back().act, false), l}))
+            consistent = false;
+    }
+    else if (name == "check-sat" || name == "check-sat-assuming")
+    {
+        const bool assuming = name == "check-sat-assuming";
+        if (cmd.es.size() != (assuming ? 2 : 1) || (assuming && !cmd.es[1].list))
+            throw error(cmd.line, assuming ? "expected '(check-sat-assuming (<term>*))'.." : "expected '(check-sat)'..");
+        backtrack();
+        std::vector<lit> assumptions;
+        for (const auto &l : levels)
+            assumptions.push_back(l.act);
+        if (assuming)
+            for (const auto &a : cmd.es[1].es)
+                assumptions.push_back(to_lit(a));
+        has_model = consistent && search.solve(assumptions);
+        os << (has_model ? "sat" : "unsat") << std::endl;
+    }
+    else if (name == "push" || name == "pop")
+    {
+        size_t n = 1;
+        if (cmd.es.size() > 2 || (cmd.es.size() == 2 && (cmd.es[1].list || cmd.es[1].atom.find_first_not_of("0123456789") != std::string::npos)))
+            throw error(cmd.line, "expected '(" + name + " <numeral>)'..");
+        if (cmd.es.size() == 2)
+            n = std::stoul(cmd.es[1].atom);
+        backtrack();
+        if (name == "push")
+            for (size_t i = 0; i < n; ++i)
+                levels.push_back({sat.new_var(), symbols.size()});
+        else
+        {
+            if (n > levels.size())
+                throw error(cmd.line, "not enough push levels..");
+            for (size_t i = 0; i < n; ++i)
+            {
+                // the assertions of the level are disabled and its symbols are removed..
+                sat.new_clause({lit(levels.back().act, false)});
+                for (size_t j = levels.back().n_symbols; j < symbols.size(); ++j)
+                    sym_idx.erase(symbols[j].name);
+                symbols.resize(levels.back().n_symbols);
+                levels.pop_back();
+            }
+        }
+    }
+    else if (name == "get-model")
+    {
+        if (!has_model)
+            throw error(cmd.line, "no model available..");
+        const rational d = delta();
+        os << "(" << std::endl;
+        for (const auto &s : symbols)
+            if (s.declared)
+            {
+                os << "  (define-fun " << quote(s.name) << " () " << (s.t.real ? "Real " : "Bool ");
+                write(s.t, d);
+                os << ")" << std::endl;
+            }
+        os << ")" << std::endl;
+    }
+    else if (name == "get-value")
+    {
+        if (cmd.es.size() != 2 || !cmd.es[1].list || cmd.es[1].es.empty())
+            throw error(cmd.line, "expected '(get-value (<term>+))'..");
+        if (!has_model)
+            throw error(cmd.line, "no model available..");
+        const rational d = delta();
+        os << "(";
+        for (const auto &e : cmd.es[1].es)
+        {
+            if (e.list) // compound boolean terms would require new variables, hence they are not supported..
+                throw error(e.line, "only the values of symbols and constants can be asked..");
+            os << (&e == &cmd.es[1].es.front() ? "(" : " (") << quote(e.atom) << " ";
+            write(to_term(e), d);
+            os << ")";
+        }
+        os << ")" << std::endl;
+    }
+    else if (name == "echo")
+    {
+        if (cmd.es.size() != 2 || cmd.es[1].list || cmd.es[1].atom.front() != '"')
+            throw error(cmd.line, "expected '(echo <string>)'..");
+        os << cmd.es[1].atom.substr(1, cmd.es[1].atom.size() - 2) << std::endl;
+    }
+    else
+        throw error(cmd.line, "unsupported command '" + name + "'..");
+    return true;
+}
+
+void smtlib_reader::new_symbol(const sexpr &e, const term &t, const bool &declared)
+{
+    if (!sym_idx.insert({e.atom, symbols.size()}).second)
+        throw error(e.line, "symbol '" + e.atom + "' already declared..");
+    symbols.push_back({e.atom, t, declared});
+}
+
+void smtlib_reader::backtrack()
+{
+    search.reset();
+    has_model = false;
+}
+
+smtlib_reader::term smtlib_reader::to_term(const sexpr &e)
+{
+    term t;
+    if (!e.list)
+    {
+        if (e.atom == "true" || e.atom == "false")
+        {
+            t.real = false;
+            t.l = lit(TRUE_var, e.atom == "true");
+        }
+        else if (std::isdigit(e.atom.front()))
+        {
+            // a numeral or a decimal..
+            const size_t dot = e.atom.find('.');
+            if (e.atom.find_first_not_of("0123456789.") != std::string::npos || dot != e.atom.rfind('.') || dot == e.atom.size() - 1)
+                throw error(e.line, "invalid number '" + e.atom + "'..");
+            t.real = true;
+            if (dot == std::string::npos)
+                t.ln = lin(rational(std::stol(e.atom)));
+            else
+            {
+                I den = 1;
+                for (size_t i = dot + 1; i < e.atom.size(); ++i)
+                    den *= 10;
+                t.ln = lin(rational(std::stol(e.atom.substr(0, dot) + e.atom.substr(dot + 1)), den));
+            }
+        }
+        else
+        {
+            // the innermost 'let' bindings hide the symbols..
+            for (auto l_it = lets.rbegin(); l_it != lets.rend(); ++l_it)
+            {
+                const auto at_l = l_it->find(e.atom);
+                if (at_l != l_it->end())
+                    return at_l->second;
+            }
+            const auto at_s = sym_idx.find(e.atom);
+            if (at_s == sym_idx.end())
+                throw error(e.line, "unknown symbol '" + e.atom + "'..");
+            return symbols[at_s->second].t;
+        }
+        return t;
+    }
+
+    if (e.es.empty() || e.es[0].list)
+        throw error(e.line, "expected a function application..");
+    const std::string &f = e.es[0].atom;
+    const size_t n_args = e.es.size() - 1;
+    if (f == "let")
+    {
+        if (n_args != 2 || !e.es[1].list || e.es[1].es.empty())
+            throw error(e.line, "expected '(let (<binding>+) <term>)'..");
+        // the bindings are evaluated in parallel..
+        std::unordered_map<std::string, term> bindings;
+        for (const auto &b : e.es[1].es)
+        {
+            if (!b.list || b.es.size() != 2 || b.es[0].list)
+                throw error(b.line, "expected '(<symbol> <term>)'..");
+            bindings[b.es[0].atom] = to_term(b.es[1]);
+        }
+        lets.push_back(bindings);
+        t = to_term(e.es[2]);
+        lets.pop_back();
+        return t;
+    }
+    else if (f == "!")
+    {
+        // annotations are ignored..
+        if (n_args == 0)
+            throw error(e.line, "expected '(! <term> <attribute>+)'..");
+        return to_term(e.es[1]);
+    }
+    else if (f == "not")
+    {
+        if (n_args != 1)
+            throw error(e.line, "'not' expects one argument..");
+        t.real = false;
+        t.l = !to_lit(e.es[1]);
+    }
+    else if (f == "and" || f == "or" || f == "=>")
+    {
+        std::vector<lit> ls;
+        for (size_t i = 1; i <= n_args; ++i)
+            ls.push_back(f == "=>" && i < n_args ? !to_lit(e.es[i]) : to_lit(e.es[i]));
+        t.real = false;
+        t.l = f == "and" ? sat.new_conj(ls) : sat.new_disj(ls);
+    }
+    else if (f == "xor")
+    {
+        if (n_args < 2)
+            throw error(e.line, "'xor' expects at least two arguments..");
+        t.real = false;
+        t.l = to_lit(e.es[1]);
+        for (size_t i = 2; i <= n_args; ++i)
+            t.l = !lit(sat.new_eq(t.l, to_lit(e.es[i])));
+    }
+    else if (f == "=" || f == "distinct")
+    {
+        if (n_args < 2)
+            throw error(e.line, "'" + f + "' expects at least two arguments..");
+        std::vector<term> ts;
+        for (size_t i = 1; i <= n_args; ++i)
+        {
+            ts.push_back(to_term(e.es[i]));
+            if (ts.back().real != ts.front().real)
+                throw error(e.es[i].line, "sort mismatch..");
+        }
+        // equalities are chained, while disequalities are pairwise..
+        std::vector<lit> ls;
+        if (f == "=")
+            for (size_t i = 1; i < ts.size(); ++i)
+                ls.push_back(to_eq(ts[i - 1], ts[i]));
+        else
+            for (size_t i = 0; i < ts.size(); ++i)
+                for (size_t j = i + 1; j < ts.size(); ++j)
+                    ls.push_back(!to_eq(ts[i], ts[j]));
+        t.real = false;
+        t.l = sat.new_conj(ls);
+    }
+    else if (f == "ite")
+    {
+        if (n_args != 3)
+            throw error(e.line, "'ite' expects three arguments..");
+        const lit c = to_lit(e.es[1]);
+        const term t_t = to_term(e.es[2]), t_e = to_term(e.es[3]);
+        if (t_t.real != t_e.real)
+            throw error(e.line, "sort mismatch..");
+        t.real = t_t.real;
+        if (t.real)
+        {
+            // a new variable which is equal to either of the branches..
+            t.ln = lin(la.new_var(), rational::ONE);
+            if (!sat.new_clause({!c, to_eq(t, t_t)}) || !sat.new_clause({c, to_eq(t, t_e)}))
+                consistent = false;
+        }
+        else
+            t.l = sat.new_disj({sat.new_conj({c, t_t.l}), sat.new_conj({!c, t_e.l})});
+    }
+    else if (f == "<=" || f == "<" || f == ">=" || f == ">")
+    {
+        if (n_args < 2)
+            throw error(e.line, "'" + f + "' expects at least two arguments..");
+        std::vector<lin> ls;
+        for (size_t i = 1; i <= n_args; ++i)
+            ls.push_back(to_lin(e.es[i]));
+        std::vector<lit> cs;
+        for (size_t i = 1; i < ls.size(); ++i)
+            if (f == "<=")
+                cs.push_back(la.new_leq(ls[i - 1], ls[i]));
+            else if (f == "<")
+                cs.push_back(la.new_lt(ls[i - 1], ls[i]));
+            else if (f == ">=")
+                cs.push_back(la.new_geq(ls[i - 1], ls[i]));
+            else
+                cs.push_back(la.new_gt(ls[i - 1], ls[i]));
+        t.real = false;
+        t.l = sat.new_conj(cs);
+    }
+    else if (f == "+" || f == "-")
+    {
+        if (n_args == 0)
+            throw error(e.line, "'" + f + "' expects at least one argument..");
+        t.real = true;
+        t.ln = to_lin(e.es[1]);
+        if (f == "-" && n_args == 1)
+            t.ln = -t.ln;
+        for (size_t i = 2; i <= n_args; ++i)
+            t.ln = f == "+" ? t.ln + to_lin(e.es[i]) : t.ln - to_lin(e.es[i]);
+    }
+    else if (f == "*")
+    {
+        if (n_args == 0)
+            throw error(e.line, "'*' expects at least one argument..");
+        // all the factors but (at most) one must be constants..
+        t.real = true;
+        t.ln = to_lin(e.es[1]);
+        for (size_t i = 2; i <= n_args; ++i)
+        {
+            const lin r = to_lin(e.es[i]);
+            if (!t.ln.vars.empty() && !r.vars.empty())
+                throw error(e.line, "non-linear terms are not supported..");
+            const bool l_const = t.ln.vars.empty();
+            const rational c = l_const ? t.ln.known_term : r.known_term;
+            t.ln = c == rational::ZERO ? lin() : (l_const ? r * c : t.ln * c);
+        }
+    }
+    else if (f == "/")
+    {
+        if (n_args < 2)
+            throw error(e.line, "'/' expects at least two arguments..");
+        t.real = true;
+        t.ln = to_lin(e.es[1]);
+        for (size_t i = 2; i <= n_args; ++i)
+        {
+            const lin r = to_lin(e.es[i]);
+            if (!r.vars.empty())
+                throw error(e.es[i].line, "non-linear terms are not supported..");
+            if (r.known_term == rational::ZERO)
+                throw error(e.es[i].line, "division by zero..");
+            t.ln = t.ln / r.known_term;
+        }
+    }
+    else
+        throw error(e.line, "unsupported function '" + f + "'..");
+    return t;
+}
+
+lit smtlib_reader::to_lit(const sexpr &e)
+{
+    const term t = to_term(e);
+    if (t.real)
+        throw error(e.line, "expected a 'Bool' term..");
+    return t.l;
+}
+
+lin smtlib_reader::to_lin(const sexpr &e)
+{
+    const term t = to_term(e);
+    if (!t.real)
+        throw error(e.line, "expected a 'Real' term..");
+    return t.ln;
+}
+
+lit smtlib_reader::to_eq(const term &l, const term &r)
+{
+    if (l.real)
+        return sat.new_conj({la.new_leq(l.ln, r.ln), la.new_geq(l.ln, r.ln)});
+    else
+        return sat.new_eq(l.l, r.l);
+}
+
+rational smtlib_reader::delta() const
+{
+    // the infinitesimals must be small enough not to violate any of the bounds..
+    rational d = rational::ONE;
+    for (var x = 0; x < la.n_vars(); ++x)
+    {
+        const inf_rational val = la.value(x), lb = la.lb(x), ub = la.ub(x);
+        if (!lb.is_negative_infinite() && lb.get_rational() < val.get_rational() && val.get_infinitesimal() < lb.get_infinitesimal())
+            d = std::min(d, (val.get_rational() - lb.get_rational()) / (lb.get_infinitesimal() - val.get_infinitesimal()));
+        if (!ub.is_positive_infinite() && val.get_rational() < ub.get_rational() && ub.get_infinitesimal() < val.get_infinitesimal())
+            d = std::min(d, (ub.get_rational() - val.get_rational()) / (val.get_infinitesimal() - ub.get_infinitesimal()));
+    }
+    return d;
+}
+
+void smtlib_reader::write(const term &t, const rational &d)
+{
+    if (!t.real)
+    {
+        os << (sat.value(t.l) == True ? "true" : "false");
+        return;
+    }
+    const inf_rational val = la.value(t.ln);
+    const rational v = val.get_rational() + val.get_infinitesimal() * d;
+    if (v.is_negative())
+        os << "(- ";
+    const I num = v.is_negative() ? -v.numerator() : v.numerator();
+    if (v.denominator() == 1)
+        os << num << ".0";
+    else
+        os << "(/ " << num << ".0 " << v.denominator() << ".0)";
+    if (v.is_negative())
+        os << ")";
+}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "sat_search.h"
+#include "la_theory.h"
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+
+namespace smt
+{
+
+struct sexpr;
+
+// interprets SMT-LIB2 scripts on a sat core and a linear arithmetic theory, writing the responses into the given stream..
+// the supported subset is that of quantifier-free linear real arithmetic (QF_LRA): constants of sort 'Bool' and 'Real' (i.e., no uninterpreted functions), 'let' terms, the core and the arithmetic operators, and the 'set-logic', 'set-info', 'set-option', 'declare-const', 'declare-fun', 'define-fun', 'assert', 'check-sat', 'check-sat-assuming', 'push', 'pop', 'get-model', 'get-value', 'echo' and 'exit' commands..
+// the assertions of each push level are guarded by an activation literal which is assumed by 'check-sat', popping a level permanently disables its assertions..
+class smtlib_reader
+{
+public:
+  smtlib_reader(sat_core &sat, la_theory &la, std::ostream &os);
+  smtlib_reader(const smtlib_reader &orig) = delete;
+  virtual ~smtlib_reader();
+
+  bool read(std::istream &is); // executes the commands of the given stream, returns false if an 'exit' command has been executed, throws an 'std::invalid_argument' if the input is malformed or not supported..
+
+private:
+  struct term
+  {
+    bool real; // whether the term is of sort 'Real' (otherwise it is of sort 'Bool')..
+    lit l;     // the literal of a 'Bool' term..
+    lin ln;    // the linear expression of a 'Real' term..
+  };
+
+  struct symbol
+  {
+    std::string name;
+    term t;
+    bool declared; // whether the symbol has been declared (otherwise it has been defined, and it is not part of the model)..
+  };
+
+  struct level
+  {
+    var act;          // the activation variable of the assertions of this level..
+    size_t n_symbols; // the number of symbols when this level has been pushed..
+  };
+
+  bool next(std::istream &is, sexpr &e);        // reads the next s-expression, returns false at the end of the stream..
+  bool execute(const sexpr &cmd);               // executes the given command, returns false if it is an 'exit' command..
+  void new_symbol(const sexpr &e, const term &t, const bool &declared);
+  void backtrack(); // removes the last model, if any, so that the sat core is at root level..
+
+  term to_term(const sexpr &e);
+  lit to_lit(const sexpr &e);
+  lin to_lin(const sexpr &e);
+  lit to_eq(const term &l, const term &r);
+
+  rational delta() const;                  // a value for the infinitesimals which satisfies the strict bounds of the current model..
+  void write(const term &t, const rational &d); // writes the value of the given term in the current model..
+
+private:
+  sat_core &sat;
+  la_theory &la;
+  sat_search search;
+  std::ostream &os;
+  size_t line = 1;                                        // the current line, for error messages..
+  std::vector<symbol> symbols;                            // the declared and defined symbols, in declaration order..
+  std::unordered_map<std::string, size_t> sym_idx;        // the symbols (string to index into 'symbols')..
+  std::vector<std::unordered_map<std::string, term>> lets; // the variables bound by the enclosing 'let' terms..
+  std::vector<level> levels;                              // the push levels..
+  bool consistent = true;                                 // false if the assertions are unsatisfiable at root level..
+  bool has_model = false;                                 // whether the last 'check-sat' has found a model which is still available..
+};
+}
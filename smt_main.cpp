@@ -0,0 +1,81 @@
+#include "sat_core.h"
+#include "la_theory.h"
+#include "sat_search.h"
+#include "dimacs.h"
+#include "smtlib_reader.h"
+#include <iostream>
+#include <fstream>
+
+// a standalone front end for the smt-lib engines:
+//
+//     lucy_smt [file.cnf | file.smt2]
+//
+// DIMACS CNF files (i.e., having the '.cnf' or the '.dimacs' extension) are solved and answered as in the SAT competitions: an 's' line, followed by the 'v' lines of the model, and the exit codes 10 (satisfiable) or 20 (unsatisfiable)..
+// any other file, as well as the standard input (if no file is given), is executed as an SMT-LIB2 script..
+static bool ends_with(const std::string &str, const std::string &suffix) { return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0; }
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2)
+    {
+        std::cerr << "usage: lucy_smt [file.cnf | file.smt2]" << std::endl;
+        return 2;
+    }
+    const std::string file_name = argc == 2 ? argv[1] : "";
+    std::ifstream ifs;
+    if (!file_name.empty())
+    {
+        ifs.open(file_name);
+        if (!ifs)
+        {
+            std::cerr << "file not found: " << file_name << std::endl;
+            return 2;
+        }
+    }
+    std::istream &is = file_name.empty() ? std::cin : ifs;
+
+    smt::sat_core sat;
+    if (ends_with(file_name, ".cnf") || ends_with(file_name, ".dimacs"))
+    {
+        try
+        {
+            smt::dimacs_reader rdr(sat);
+            smt::sat_search search(sat);
+            if (!rdr.read(is) || !search.solve())
+            {
+                std::cout << "s UNSATISFIABLE" << std::endl;
+                return 20;
+            }
+            std::cout << "s SATISFIABLE" << std::endl;
+            for (size_t i = 1; i <= rdr.n_vars(); ++i)
+            {
+                if (i % 10 == 1)
+                    std::cout << (i > 1 ? "\nv" : "v");
+                std::cout << ' ' << (sat.value(rdr.get_var(i)) == smt::True ? "" : "-") << i;
+            }
+            std::cout << (rdr.n_vars() ? "\nv 0" : "v 0") << std::endl;
+            return 10;
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            return 1;
+        }
+    }
+
+    smt::la_theory la(sat);
+    smt::smtlib_reader rdr(sat, la, std::cout);
+    try
+    {
+        rdr.read(is);
+    }
+    catch (const std::exception &ex)
+    {
+        // as in SMT-LIB2, errors are reported on the regular output..
+        std::string msg = ex.what();
+        for (size_t pos = msg.find('"'); pos != std::string::npos; pos = msg.find('"', pos + 2))
+            msg.insert(pos, 1, '"');
+        std::cout << "(error \"" << msg << "\")" << std::endl;
+        return 1;
+    }
+}
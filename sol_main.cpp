@@ -0,0 +1,60 @@
+#include "solution_format.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+// reads back a binary solution (see 'solution_format.h'), checking it, and prints a summary of its content:
+//
+//     lucy_sol solution.sol
+//
+// the exit code is 0 if the solution is well formed, 1 otherwise..
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "usage: lucy_sol solution.sol" << std::endl;
+        return 2;
+    }
+
+    std::ifstream ifs(argv[1], std::ios::binary | std::ios::ate);
+    if (!ifs)
+    {
+        std::cerr << "file not found: " << argv[1] << std::endl;
+        return 2;
+    }
+    const size_t size = static_cast<size_t>(ifs.tellg());
+    std::vector<uint64_t> buf((size + sizeof(uint64_t) - 1) / sizeof(uint64_t)); // the tables of a solution are 8-byte aligned..
+    ifs.seekg(0);
+    ifs.read(reinterpret_cast<char *>(buf.data()), size);
+
+    try
+    {
+        const lucy::solution_view sol(reinterpret_cast<const char *>(buf.data()), size);
+        size_t n_active = 0, n_unified = 0, n_inactive = 0;
+        for (size_t i = 0; i < sol.n_atoms(); ++i)
+            switch (sol.atom(i).state)
+            {
+            case lucy::ACTIVE_ATOM:
+                n_active++;
+                break;
+            case lucy::UNIFIED_ATOM:
+                n_unified++;
+                break;
+            default:
+                n_inactive++;
+            }
+        std::cout << "predicates: " << sol.n_predicates() << std::endl;
+        for (size_t i = 0; i < sol.n_predicates(); ++i)
+            std::cout << "  " << sol.predicate(i) << std::endl;
+        std::cout << "atoms: " << sol.n_atoms() << " (" << n_active << " active, " << n_unified << " unified, " << n_inactive << " inactive)" << std::endl;
+        std::cout << "values: " << sol.header().n_values << " (" << sol.header().n_enum_items << " allowed items of enumerative values)" << std::endl;
+        std::cout << "refs: " << sol.n_refs() << std::endl;
+        for (size_t i = 0; i < sol.n_refs(); ++i)
+            std::cout << "  " << sol.string(sol.refs()[i].name) << std::endl;
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}